@@ -0,0 +1,108 @@
+/*
+ * Throughput of WorkerPool from 1 to WORKERPOOL_MAX_WORKERS workers. Built
+ * for the FreeRTOS POSIX (Linux) port, with configNUMBER_OF_CORES > 1 the
+ * workers run on several cores:
+ *
+ *     g++ -O2 -I<dir of xXx> -I<FreeRTOSConfig.h> -I<kernel>/include
+ *         -I<kernel>/portable/ThirdParty/GCC/Posix
+ *         workerpool_benchmark.cpp ../os/workerpool.cpp ../os/simpletask.cpp
+ *         <kernel and port sources> -lpthread
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <xXx/os/simpletask.hpp>
+#include <xXx/os/workerpool.hpp>
+
+static const uint32_t numberOfJobs = 4096;
+static const uint32_t blockSize    = 1024;
+static const uint8_t rounds        = 3;
+
+struct Block {
+    uint8_t bytes[blockSize];
+    uint32_t crc;
+};
+
+static Block blocks[numberOfJobs];
+
+static void crcJob(void *argument) {
+    Block *block = static_cast<Block *>(argument);
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (uint32_t i = 0; i < blockSize; i++) {
+        crc ^= block->bytes[i];
+
+        for (uint8_t k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+
+    block->crc = ~crc;
+}
+
+class Benchmark : public xXx::SimpleTask {
+   private:
+    uint32_t run(uint8_t numWorkers) {
+        xXx::WorkerPool *pool = new xXx::WorkerPool;
+        TickType_t best       = portMAX_DELAY;
+
+        pool->create(numWorkers, 2 * configMINIMAL_STACK_SIZE);
+
+        for (uint8_t round = 0; round < rounds; round++) {
+            xXx::WorkerPool_Group group;
+            TickType_t start = xTaskGetTickCount();
+
+            for (uint32_t i = 0; i < numberOfJobs; i++) {
+                pool->submit(crcJob, &blocks[i], &group);
+            }
+
+            pool->join(group);
+
+            TickType_t ticks = xTaskGetTickCount() - start;
+            if (ticks < best) best = ticks;
+        }
+
+        delete pool;
+
+        if (best == 0) best = 1;
+
+        return ((numberOfJobs * configTICK_RATE_HZ) / best);
+    }
+
+    void setup() {
+        for (uint32_t i = 0; i < numberOfJobs; i++) {
+            for (uint32_t k = 0; k < blockSize; k++) {
+                blocks[i].bytes[k] = i + k;
+            }
+        }
+    }
+
+    void loop() {
+        uint32_t single = run(1);
+
+        printf("workers  jobs/s  speedup\n");
+        printf("%7u %7lu %8.2f\n", 1, static_cast<unsigned long>(single), 1.0);
+
+        for (uint8_t numWorkers = 2; numWorkers <= WORKERPOOL_MAX_WORKERS; numWorkers++) {
+            uint32_t throughput = run(numWorkers);
+
+            printf("%7u %7lu %8.2f\n", numWorkers, static_cast<unsigned long>(throughput),
+                   static_cast<double>(throughput) / single);
+        }
+
+        vTaskEndScheduler();
+    }
+};
+
+int main() {
+    static Benchmark benchmark;
+
+    benchmark.create(4 * configMINIMAL_STACK_SIZE, Task_Priority_HIGH);
+    vTaskStartScheduler();
+
+    return (0);
+}
@@ -1,3 +1,5 @@
+#define LOG_MODULE RF24
+
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -7,6 +9,7 @@
 #include <xXx/interfaces/ispi.hpp>
 #include <xXx/utils/bitoperations.hpp>
 #include <xXx/utils/logging.hpp>
+#include <xXx/utils/trace.hpp>
 
 #include <nRF24L01_config.h>
 
@@ -30,12 +33,17 @@ RF24::RF24(ISpi &spi, IGpio &ce, IGpio &irq)
     : RF24_BASE(spi),
       ce(ce),
       irq(irq),
-      rxBuffer(CircularBuffer<RF24_DataPackage_t>(6)) {
-    LOG("%s: %p\n", __FUNCTION__, this);
+      rxBuffer{CircularBuffer<RF24_DataPackage_t>(rxQueueDepth),
+               CircularBuffer<RF24_DataPackage_t>(rxQueueDepth),
+               CircularBuffer<RF24_DataPackage_t>(rxQueueDepth),
+               CircularBuffer<RF24_DataPackage_t>(rxQueueDepth),
+               CircularBuffer<RF24_DataPackage_t>(rxQueueDepth),
+               CircularBuffer<RF24_DataPackage_t>(rxQueueDepth)} {
+    LOG_DEBUG("%s: %p\n", __FUNCTION__, this);
 }
 
 RF24::~RF24() {
-    LOG("%s: %p\n", __FUNCTION__, this);
+    LOG_DEBUG("%s: %p\n", __FUNCTION__, this);
 }
 
 void RF24::setup() {
@@ -43,6 +51,7 @@ void RF24::setup() {
 
     IGpio_Callback_t interruptFunction = [](void *user) {
         RF24 *self = static_cast<RF24 *>(user);
+        TRACE_INSTANT("rf24 irq");
         self->increaseNotificationCounter();
         // TODO: Read FIFO from here?
     };
@@ -68,16 +77,11 @@ void RF24::setup() {
 }
 
 void RF24::loop() {
+    TRACE_SCOPE("rf24 loop");
+
     uint8_t status;
 
-    if (rxBuffer.itemsAvailable()) {
-        RF24_DataPackage_t package;
-        rxBuffer.pop(package);
-
-        if (rxCallback[package.pipe]) {
-            rxCallback[package.pipe](package, rxUser[package.pipe]);
-        }
-    }
+    deliverRxPackages();
 
     if (!decreaseNotificationCounter()) return;
 
@@ -88,6 +92,42 @@ void RF24::loop() {
     W_REGISTER(RF24_Register::STATUS, &status);
 }
 
+bool RF24::hasPendingEvents() {
+    __BOUNCE(notificationCounter > 0, true);
+
+    for (uint8_t pipe = 0; pipe <= numPipes; pipe++) {
+        __BOUNCE(rxBuffer[pipe].itemsAvailable() > 0, true);
+    }
+
+    return (false);
+}
+
+void RF24::setCapture(RF24_Capture *capture) {
+    this->capture = capture;
+}
+
+void RF24::deliverRxPackages() {
+    // Weighted round robin: every pipe delivers up to its weight per call and
+    // the first pipe rotates, so a busy pipe cannot starve the others.
+    for (uint8_t i = 0; i <= numPipes; i++) {
+        uint8_t pipe = (rxNextPipe + i) % (numPipes + 1);
+
+        for (uint8_t j = 0; j < rxWeight[pipe]; j++) {
+            RF24_DataPackage_t package;
+
+            if (!rxBuffer[pipe].pop(package)) break;
+
+            rxStatistics[pipe].deliveredPackages++;
+
+            if (rxCallback[pipe]) {
+                rxCallback[pipe](package, rxUser[pipe]);
+            }
+        }
+    }
+
+    rxNextPipe = (rxNextPipe + 1) % (numPipes + 1);
+}
+
 bool RF24::increaseNotificationCounter() {
     __BOUNCE(notificationCounter == __UINT8_MAX__, false);
 
@@ -115,11 +155,22 @@ void RF24::handle_TX_DS(uint8_t status) {
 }
 
 void RF24::handle_RX_DR(uint8_t status) {
-    RF24_Status error = readRxFifo(status);
-    if (error != RF24_Status::Success) FLUSH_RX();
+    // Drain the whole RX FIFO, the hardware holds up to three packages
+    while (extractPipe(status) <= numPipes) {
+        RF24_Status error = readRxFifo(status);
+
+        if (error != RF24_Status::Success) {
+            FLUSH_RX();
+            return;
+        }
+
+        status = NOP();
+    }
 }
 
 RF24_Status RF24::readRxFifo(uint8_t status) {
+    TRACE_SCOPE("rf24 rx fifo");
+
     RF24_DataPackage_t package;
     bool success;
 
@@ -131,8 +182,15 @@ RF24_Status RF24::readRxFifo(uint8_t status) {
 
     R_RX_PAYLOAD(package.bytes, package.numBytes);
 
-    success = rxBuffer.push(package);
-    __BOUNCE(!success, RF24_Status::Failure);
+    if (capture) capture->record(false, package.pipe, status, 0, package.bytes, package.numBytes);
+
+    rxStatistics[package.pipe].receivedPackages++;
+    rxStatistics[package.pipe].receivedBytes += package.numBytes;
+
+    // The package is already out of the FIFO, a full queue only costs this
+    // pipe its package instead of flushing everybody else's.
+    success = rxBuffer[package.pipe].push(package);
+    if (!success) rxStatistics[package.pipe].droppedPackages++;
 
     return (RF24_Status::Success);
 }
@@ -149,50 +207,152 @@ RF24_Status RF24::writeTxFifo(uint8_t status) {
     return (RF24_Status::Success);
 }
 
+uint8_t RF24::readConfig() {
+    if (!configValid) {
+        R_REGISTER(RF24_Register::CONFIG, &configRegister);
+        configValid = true;
+    }
+
+    return (configRegister);
+}
+
+void RF24::writeConfig(uint8_t newConfig) {
+    if (configValid && newConfig == configRegister) return;
+
+    W_REGISTER(RF24_Register::CONFIG, &newConfig);
+
+    configRegister = newConfig;
+    configValid    = true;
+}
+
 void RF24::enterRxMode() {
-    uint8_t config;
+    if (mode == RF24_Mode::Rx) return;
 
-    R_REGISTER(RF24_Register::CONFIG, &config);
-    setBit_eq<uint8_t>(config, CONFIG_PWR_UP);
-    setBit_eq<uint8_t>(config, CONFIG_PRIM_RX);
-    W_REGISTER(RF24_Register::CONFIG, &config);
+    uint8_t newConfig = readConfig();
+    bool poweredDown  = !readBit<uint8_t>(newConfig, CONFIG_PWR_UP);
+
+    // PRIM_RX must not change while CE is high
+    ce.clear();
+
+    setBit_eq<uint8_t>(newConfig, CONFIG_PWR_UP);
+    setBit_eq<uint8_t>(newConfig, CONFIG_PRIM_RX);
+    writeConfig(newConfig);
+
+    if (poweredDown) delayUs(powerUpDelay);
 
     ce.set();
 
     delayUs(rxSettling);
+
+    mode = RF24_Mode::Rx;
 }
 
 void RF24::enterShutdownMode() {
-    uint8_t config;
+    if (mode == RF24_Mode::Shutdown) return;
+
+    uint8_t newConfig = readConfig();
 
     ce.clear();
 
-    R_REGISTER(RF24_Register::CONFIG, &config);
-    clearBit_eq<uint8_t>(config, CONFIG_PWR_UP);
-    W_REGISTER(RF24_Register::CONFIG, &config);
+    clearBit_eq<uint8_t>(newConfig, CONFIG_PWR_UP);
+    writeConfig(newConfig);
+
+    mode = RF24_Mode::Shutdown;
 }
 
 void RF24::enterStandbyMode() {
-    uint8_t config;
+    if (mode == RF24_Mode::Standby) return;
+
+    uint8_t newConfig = readConfig();
+    bool poweredDown  = !readBit<uint8_t>(newConfig, CONFIG_PWR_UP);
 
     ce.clear();
 
-    R_REGISTER(RF24_Register::CONFIG, &config);
-    setBit_eq<uint8_t>(config, CONFIG_PWR_UP);
-    W_REGISTER(RF24_Register::CONFIG, &config);
+    setBit_eq<uint8_t>(newConfig, CONFIG_PWR_UP);
+    writeConfig(newConfig);
+
+    if (poweredDown) delayUs(powerUpDelay);
+
+    mode = RF24_Mode::Standby;
 }
 
 void RF24::enterTxMode() {
-    uint8_t config;
+    if (mode == RF24_Mode::Tx) return;
 
-    R_REGISTER(RF24_Register::CONFIG, &config);
-    setBit_eq<uint8_t>(config, CONFIG_PWR_UP);
-    clearBit_eq<uint8_t>(config, CONFIG_PRIM_RX);
-    W_REGISTER(RF24_Register::CONFIG, &config);
+    uint8_t newConfig = readConfig();
+    bool poweredDown  = !readBit<uint8_t>(newConfig, CONFIG_PWR_UP);
+
+    // PRIM_RX must not change while CE is high
+    ce.clear();
+
+    setBit_eq<uint8_t>(newConfig, CONFIG_PWR_UP);
+    clearBit_eq<uint8_t>(newConfig, CONFIG_PRIM_RX);
+    writeConfig(newConfig);
+
+    if (poweredDown) delayUs(powerUpDelay);
 
     ce.set();
 
     delayUs(txSettling);
+
+    mode = RF24_Mode::Tx;
+}
+
+void RF24::turnaround() {
+    // Straight from one direction to the other, CONFIG comes from the cache
+    // and the power up delay is never needed.
+    switch (mode) {
+        case RF24_Mode::Rx: enterTxMode(); break;
+        case RF24_Mode::Tx: enterRxMode(); break;
+        default: break;
+    }
+}
+
+RF24_Mode RF24::getMode() {
+    return (mode);
+}
+
+RF24_Status RF24::send(const uint8_t *bytes, uint8_t numBytes) {
+    uint32_t waited = 0;
+    uint8_t status;
+
+    __BOUNCE(numBytes > txFifoSize, RF24_Status::Failure);
+
+    // In TX mode CE is still high and the payload goes out right away
+    if (mode != RF24_Mode::Tx) enterStandbyMode();
+
+    W_TX_PAYLOAD(bytes, numBytes);
+    enterTxMode();
+
+    // 15 retries with the longest retry delay take about 64 ms, a radio that
+    // has not answered after txTimeout is gone or stuck
+    for (;;) {
+        status = NOP();
+
+        if (readBit<uint8_t>(status, STATUS_TX_DS) || readBit<uint8_t>(status, STATUS_MAX_RT)) break;
+
+        if (waited >= txTimeout) {
+            LOG_ERROR("%s: %p timed out\n", __FUNCTION__, this);
+            FLUSH_TX();
+            return (RF24_Status::Timeout);
+        }
+
+        delayUs(txPollInterval);
+        waited += txPollInterval;
+    }
+
+    // Clear only the TX flags, RX_DR is left for loop()
+    uint8_t txFlags = AND<uint8_t>(status, STATUS_TX_DS_MASK | STATUS_MAX_RT_MASK);
+    W_REGISTER(RF24_Register::STATUS, &txFlags);
+
+    if (capture) capture->record(true, 0, status, getRetransmissionCounter(), bytes, numBytes);
+
+    if (readBit<uint8_t>(status, STATUS_MAX_RT)) {
+        FLUSH_TX();
+        return (RF24_Status::Failure);
+    }
+
+    return (RF24_Status::Success);
 }
 
 RF24_Status RF24::startListening(uint8_t pipe, RF24_RxCallback_t callback, void *user) {
@@ -221,6 +381,31 @@ RF24_Status RF24::stopListening(uint8_t pipe) {
     return (RF24_Status::Success);
 }
 
+RF24_Status RF24::setPipeWeight(uint8_t pipe, uint8_t weight) {
+    __BOUNCE(pipe > numPipes, RF24_Status::UnknownPipe);
+    __BOUNCE(weight == 0, RF24_Status::Failure);
+
+    rxWeight[pipe] = weight;
+
+    return (RF24_Status::Success);
+}
+
+RF24_Status RF24::getPipeStatistics(uint8_t pipe, RF24_PipeStatistics_t &statistics) {
+    __BOUNCE(pipe > numPipes, RF24_Status::UnknownPipe);
+
+    statistics = rxStatistics[pipe];
+
+    return (RF24_Status::Success);
+}
+
+RF24_Status RF24::resetPipeStatistics(uint8_t pipe) {
+    __BOUNCE(pipe > numPipes, RF24_Status::UnknownPipe);
+
+    rxStatistics[pipe] = RF24_PipeStatistics_t();
+
+    return (RF24_Status::Success);
+}
+
 uint8_t RF24::getPackageLossCounter() {
     uint8_t observe_tx;
 
@@ -278,9 +463,7 @@ RF24_CRCConfig RF24::getCrcConfig() {
 }
 
 RF24_Status RF24::setCrcConfig(RF24_CRCConfig crcConfig) {
-    uint8_t config;
-
-    R_REGISTER(RF24_Register::CONFIG, &config);
+    uint8_t config = readConfig();
 
     switch (crcConfig) {
         case RF24_CRCConfig::CRC_DISABLED: {
@@ -296,7 +479,7 @@ RF24_Status RF24::setCrcConfig(RF24_CRCConfig crcConfig) {
         } break;
     }
 
-    W_REGISTER(RF24_Register::CONFIG, &config);
+    writeConfig(config);
 
     __BOUNCE(crcConfig != getCrcConfig(), RF24_Status::VerificationFailed);
 
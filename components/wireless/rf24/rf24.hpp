@@ -4,10 +4,10 @@
 #include <stdint.h>
 
 #include <xXx/components/wireless/rf24/rf24_base.hpp>
+#include <xXx/components/wireless/rf24/rf24_capture.hpp>
 #include <xXx/components/wireless/rf24/rf24_types.hpp>
 #include <xXx/interfaces/igpio.hpp>
 #include <xXx/interfaces/ispi.hpp>
-#include <xXx/os/simpletask.hpp>
 #include <xXx/templates/circularbuffer.hpp>
 
 namespace xXx {
@@ -16,14 +16,24 @@ class RF24 : public RF24_BASE {
    private:
     IGpio &ce;
     IGpio &irq;
-    CircularBuffer<RF24_DataPackage_t> rxBuffer;
+    CircularBuffer<RF24_DataPackage_t> rxBuffer[6];
 
     uint8_t notificationCounter = 0;
     uint8_t addressLength       = 5;
 
+    RF24_Mode mode         = RF24_Mode::Unknown;
+    uint8_t configRegister = 0;
+    bool configValid       = false;
+
+    RF24_Capture *capture = NULL;
+
     RF24_RxCallback_t rxCallback[6] = {};
     void *rxUser[6]                 = {};
 
+    uint8_t rxWeight[6]                   = {1, 1, 1, 1, 1, 1};
+    uint8_t rxNextPipe                    = 0;
+    RF24_PipeStatistics_t rxStatistics[6] = {};
+
     // Copy constructor
     RF24(const RF24 &other) = default;
 
@@ -43,6 +53,11 @@ class RF24 : public RF24_BASE {
     void handle_RX_DR(uint8_t status);
     void handle_TX_DS(uint8_t status);
 
+    void deliverRxPackages();
+
+    uint8_t readConfig();
+    void writeConfig(uint8_t newConfig);
+
     RF24_Status readRxFifo(uint8_t status);
     RF24_Status writeTxFifo(uint8_t status);
 
@@ -53,10 +68,18 @@ class RF24 : public RF24_BASE {
     void setup();
     void loop();
 
+    bool hasPendingEvents();
+    void setCapture(RF24_Capture *capture);
+
     void enterRxMode();
     void enterShutdownMode();
     void enterStandbyMode();
     void enterTxMode();
+    void turnaround();
+
+    RF24_Mode getMode();
+
+    RF24_Status send(const uint8_t *bytes, uint8_t numBytes);
 
     RF24_Status startListening(uint8_t pipe, RF24_RxCallback_t callback = NULL, void *user = NULL);
     RF24_Status stopListening(uint8_t pipe);
@@ -65,6 +88,10 @@ class RF24 : public RF24_BASE {
     RF24_Status enableDataPipe(uint8_t pipe, bool enable = true);
     RF24_Status enableAutoAcknowledgment(uint8_t pipe, bool enable = true);
 
+    RF24_Status setPipeWeight(uint8_t pipe, uint8_t weight);
+    RF24_Status getPipeStatistics(uint8_t pipe, RF24_PipeStatistics_t &statistics);
+    RF24_Status resetPipeStatistics(uint8_t pipe);
+
     uint8_t getRetransmissionCounter();
     uint8_t getPackageLossCounter();
 
@@ -6,6 +6,7 @@
 #include <xXx/components/wireless/rf24/rf24_types.hpp>
 #include <xXx/interfaces/ispi.hpp>
 #include <xXx/utils/bitoperations.hpp>
+#include <xXx/utils/trace.hpp>
 
 static const uint8_t dummyByte = 0xFF;
 
@@ -22,6 +23,8 @@ RF24_BASE::RF24_BASE(ISpi &spi)
 RF24_BASE::~RF24_BASE() {}
 
 uint8_t RF24_BASE::transmit(uint8_t command, const uint8_t *txBytes, uint8_t *rxBytes, size_t numBytes) {
+    TRACE_SCOPE("rf24 spi");
+
     uint8_t status;
     uint8_t buffer[numBytes + 1];
 
@@ -35,6 +38,9 @@ uint8_t RF24_BASE::transmit(uint8_t command, const uint8_t *txBytes, uint8_t *rx
 
     _spi.transmit_receive(buffer, buffer, numBytes + 1);
 
+    _spiTransactions++;
+    _spiBytes += numBytes + 1;
+
     status = buffer[0];
 
     if (rxBytes != NULL) {
@@ -121,4 +127,12 @@ uint8_t RF24_BASE::NOP() {
     return (status);
 }
 
+uint32_t RF24_BASE::getSpiTransactions() {
+    return (_spiTransactions);
+}
+
+uint32_t RF24_BASE::getSpiBytes() {
+    return (_spiBytes);
+}
+
 } /* namespace xXx */
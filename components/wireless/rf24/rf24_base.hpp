@@ -12,6 +12,9 @@ class RF24_BASE {
    private:
     ISpi &_spi;
 
+    uint32_t _spiTransactions = 0;
+    uint32_t _spiBytes        = 0;
+
     uint8_t transmit(uint8_t command, const uint8_t *txBytes, uint8_t *rxBytes, size_t numBytes);
 
    protected:
@@ -29,6 +32,10 @@ class RF24_BASE {
     uint8_t W_ACK_PAYLOAD(uint8_t pipe, const uint8_t *bytes, size_t numBytes);
     uint8_t W_TX_PAYLOAD_NOACK(const uint8_t *bytes, size_t numBytes);
     uint8_t NOP();
+
+   public:
+    uint32_t getSpiTransactions();
+    uint32_t getSpiBytes();
 };
 
 } /* namespace xXx */
@@ -0,0 +1,93 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <xXx/components/wireless/rf24/rf24_capture.hpp>
+#include <xXx/utils/bitoperations.hpp>
+
+namespace xXx {
+
+RF24_Capture::RF24_Capture(uint8_t *buffer, size_t bufferSize, RF24_Clock_t clock)
+    : buffer(buffer), bufferSize(bufferSize), clock(clock), head(0), tail(0) {}
+
+void RF24_Capture::copyIn(size_t position, const void *bytes, size_t numBytes) {
+    size_t offset = position % bufferSize;
+    size_t first  = bufferSize - offset;
+
+    if (first > numBytes) first = numBytes;
+
+    memcpy(&buffer[offset], bytes, first);
+    memcpy(buffer, static_cast<const uint8_t *>(bytes) + first, numBytes - first);
+}
+
+void RF24_Capture::copyOut(size_t position, void *bytes, size_t numBytes) {
+    size_t offset = position % bufferSize;
+    size_t first  = bufferSize - offset;
+
+    if (first > numBytes) first = numBytes;
+
+    memcpy(bytes, &buffer[offset], first);
+    memcpy(static_cast<uint8_t *>(bytes) + first, buffer, numBytes - first);
+}
+
+void RF24_Capture::record(bool tx, uint8_t pipe, uint8_t status, uint8_t retransmits, const uint8_t *bytes, uint8_t numBytes) {
+    RF24_CaptureRecord_t record;
+
+    size_t position = head.load(std::memory_order_relaxed);
+    size_t used     = (position + bufferSize - tail.load(std::memory_order_acquire)) % bufferSize;
+
+    // One byte stays free to tell a full buffer from an empty one
+    if (used + sizeof(record) + numBytes >= bufferSize) {
+        droppedRecords++;
+        return;
+    }
+
+    record.timestamp   = clock();
+    record.flags       = AND<uint8_t>(pipe, RF24_CAPTURE_PIPE_MASK);
+    record.status      = status;
+    record.retransmits = retransmits;
+    record.numBytes    = numBytes;
+
+    if (tx) setBit_eq<uint8_t>(record.flags, RF24_CAPTURE_TX);
+
+    copyIn(position, &record, sizeof(record));
+    copyIn(position + sizeof(record), bytes, numBytes);
+
+    head.store((position + sizeof(record) + numBytes) % bufferSize, std::memory_order_release);
+}
+
+size_t RF24_Capture::read(uint8_t *bytes, size_t maxBytes) {
+    size_t position = tail.load(std::memory_order_relaxed);
+    size_t end      = head.load(std::memory_order_acquire);
+    size_t numBytes = 0;
+
+    // Whole records only, so the stream can be cut anywhere between reads
+    while (position != end) {
+        RF24_CaptureRecord_t record;
+
+        copyOut(position, &record, sizeof(record));
+
+        size_t recordSize = sizeof(record) + record.numBytes;
+
+        if (numBytes + recordSize > maxBytes) break;
+
+        copyOut(position, &bytes[numBytes], recordSize);
+
+        position = (position + recordSize) % bufferSize;
+        numBytes += recordSize;
+    }
+
+    tail.store(position, std::memory_order_release);
+
+    return (numBytes);
+}
+
+size_t RF24_Capture::bytesAvailable() {
+    return ((head.load(std::memory_order_acquire) + bufferSize - tail.load(std::memory_order_relaxed)) % bufferSize);
+}
+
+uint32_t RF24_Capture::getDroppedRecords() {
+    return (droppedRecords);
+}
+
+} /* namespace xXx */
@@ -0,0 +1,68 @@
+#ifndef RF24_CAPTURE_HPP
+#define RF24_CAPTURE_HPP
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <xXx/components/wireless/rf24/rf24_types.hpp>
+
+namespace xXx {
+
+enum RF24_CaptureFlags : uint8_t
+{
+    RF24_CAPTURE_PIPE      = 0,
+    RF24_CAPTURE_PIPE_MASK = 0b00000111,
+    RF24_CAPTURE_TX        = 7,
+    RF24_CAPTURE_TX_MASK   = 0b10000000
+};
+
+/*
+ * One record in the capture stream, followed by numBytes payload bytes.
+ * Records are stored back to back without padding.
+ */
+struct RF24_CaptureRecord_t {
+    uint32_t timestamp;
+    uint8_t flags;
+    uint8_t status;
+    uint8_t retransmits;
+    uint8_t numBytes;
+};
+
+/*
+ * Binary ring buffer for the packages RF24 receives and sends. Recording and
+ * reading may happen in different tasks, one of each. A record that does not
+ * fit is dropped and counted.
+ */
+class RF24_Capture {
+   private:
+    uint8_t *buffer;
+    size_t bufferSize;
+    RF24_Clock_t clock;
+
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    uint32_t droppedRecords = 0;
+
+    // Copy constructor
+    RF24_Capture(const RF24_Capture &other) = delete;
+
+    // Copy assignment operator
+    RF24_Capture &operator=(const RF24_Capture &other) = delete;
+
+    void copyIn(size_t position, const void *bytes, size_t numBytes);
+    void copyOut(size_t position, void *bytes, size_t numBytes);
+
+   public:
+    RF24_Capture(uint8_t *buffer, size_t bufferSize, RF24_Clock_t clock);
+
+    void record(bool tx, uint8_t pipe, uint8_t status, uint8_t retransmits, const uint8_t *bytes, uint8_t numBytes);
+    size_t read(uint8_t *bytes, size_t maxBytes);
+
+    size_t bytesAvailable();
+    uint32_t getDroppedRecords();
+};
+
+} /* namespace xXx */
+
+#endif  // RF24_CAPTURE_HPP
@@ -0,0 +1,166 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "../../../thirdparty/Catch/single_include/catch.hpp"
+
+#include <xXx/components/wireless/rf24/rf24_capture.hpp>
+#include <xXx/components/wireless/rf24/rf24_replay.hpp>
+
+static uint32_t now = 0;
+
+static uint32_t fakeClock() {
+    return (now += 10);
+}
+
+static void countInterrupt(void *user) {
+    (*static_cast<int *>(user))++;
+}
+
+// One command as RF24_BASE sends it, the answer replaces the bytes
+static uint8_t command(xXx::RF24_Replay &replay, RF24_Command command, uint8_t *bytes = NULL, size_t numBytes = 0) {
+    uint8_t buffer[1 + rxFifoSize] = {static_cast<uint8_t>(command)};
+
+    if (bytes) memcpy(&buffer[1], bytes, numBytes);
+    replay.transmit_receive(buffer, buffer, 1 + numBytes);
+    if (bytes) memcpy(bytes, &buffer[1], numBytes);
+
+    return (buffer[0]);
+}
+
+TEST_CASE("", "[RF24_Capture]") {
+    static uint8_t buffer[256];
+    static uint8_t stream[256];
+    const uint8_t payload[] = {1, 2, 3, 4, 5};
+
+    xXx::RF24_Capture capture(buffer, sizeof(buffer), fakeClock);
+    xXx::RF24_CaptureRecord_t record;
+
+    now = 0;
+
+    // The stream format is fixed, records are not padded
+    REQUIRE(sizeof(record) == 8);
+
+    capture.record(false, 3, 0x40, 0, payload, sizeof(payload));
+    capture.record(true, 0, 0x20, 2, payload, 2);
+
+    const size_t streamSize = 2 * sizeof(record) + sizeof(payload) + 2;
+
+    REQUIRE(capture.bytesAvailable() == streamSize);
+    REQUIRE(capture.read(stream, sizeof(stream)) == streamSize);
+    CHECK(capture.bytesAvailable() == 0);
+
+    memcpy(&record, stream, sizeof(record));
+    CHECK(record.timestamp == 10);
+    CHECK(record.flags == 3);
+    CHECK(record.status == 0x40);
+    CHECK(record.numBytes == sizeof(payload));
+    CHECK(memcmp(&stream[sizeof(record)], payload, sizeof(payload)) == 0);
+
+    memcpy(&record, &stream[sizeof(record) + sizeof(payload)], sizeof(record));
+    CHECK(record.timestamp == 20);
+    CHECK(record.flags == xXx::RF24_CAPTURE_TX_MASK);
+    CHECK(record.retransmits == 2);
+    CHECK(record.numBytes == 2);
+}
+
+TEST_CASE("", "[RF24_Capture]") {
+    static uint8_t buffer[100];
+    static uint8_t stream[100];
+    const uint8_t payload[32] = {};
+
+    xXx::RF24_Capture capture(buffer, sizeof(buffer), fakeClock);
+
+    // 40 bytes each, the third one does not fit
+    for (int i = 0; i < 3; i++) {
+        capture.record(false, 0, 0, 0, payload, sizeof(payload));
+    }
+
+    CHECK(capture.getDroppedRecords() == 1);
+
+    // Only whole records are read
+    CHECK(capture.read(stream, 60) == 40);
+    CHECK(capture.bytesAvailable() == 40);
+
+    // The next records wrap around the end of the buffer
+    capture.record(false, 0, 0, 0, payload, sizeof(payload));
+    CHECK(capture.getDroppedRecords() == 1);
+    CHECK(capture.read(stream, sizeof(stream)) == 80);
+    CHECK(capture.bytesAvailable() == 0);
+}
+
+TEST_CASE("", "[RF24_Replay]") {
+    const int numberOfRecords = 60;
+
+    static uint8_t buffer[4096];
+    static uint8_t stream[4096];
+
+    xXx::RF24_Capture capture(buffer, sizeof(buffer), fakeClock);
+    int interrupts = 0;
+    int received   = 0;
+    bool matches   = true;
+
+    for (int i = 0; i < numberOfRecords; i++) {
+        uint8_t payload[rxFifoSize];
+
+        memset(payload, i, sizeof(payload));
+        capture.record(i % 4 == 0, i % 6, 0x40, 0, payload, 1 + i % rxFifoSize);
+    }
+
+    size_t streamSize = capture.read(stream, sizeof(stream));
+    REQUIRE(capture.getDroppedRecords() == 0);
+
+    xXx::RF24_Replay replay(stream, streamSize);
+    replay.enableInterrupt(countInterrupt, &interrupts);
+
+    // Every received record comes back through the RX FIFO, sent ones are skipped
+    for (int i = 0; i < numberOfRecords; i++) {
+        if (i % 4 == 0) continue;
+
+        REQUIRE(replay.step());
+
+        uint8_t status = command(replay, RF24_Command::NOP);
+        uint8_t width = 0, payload[rxFifoSize];
+
+        command(replay, RF24_Command::R_RX_PL_WID, &width, 1);
+        command(replay, RF24_Command::R_RX_PAYLOAD, payload, width);
+
+        matches = matches && (status & (1 << STATUS_RX_DR));
+        matches = matches && ((status & STATUS_RX_P_NO_MASK) >> STATUS_RX_P_NO) == i % 6;
+        matches = matches && width == 1 + i % rxFifoSize;
+        matches = matches && payload[0] == i && payload[width - 1] == i;
+
+        // Cleared by writing a one, like on the radio
+        uint8_t clearRxDr = 1 << STATUS_RX_DR;
+        command(replay, static_cast<RF24_Command>(static_cast<uint8_t>(RF24_Command::W_REGISTER) | static_cast<uint8_t>(RF24_Register::STATUS)), &clearRxDr, 1);
+        matches = matches && !(command(replay, RF24_Command::NOP) & (1 << STATUS_RX_DR));
+
+        received++;
+    }
+
+    CHECK(matches);
+    CHECK_FALSE(replay.step());
+    CHECK(interrupts == received);
+
+    // Sent packages are acknowledged right away
+    uint8_t payload[4] = {};
+    command(replay, RF24_Command::W_TX_PAYLOAD, payload, sizeof(payload));
+    CHECK(command(replay, RF24_Command::NOP) & (1 << STATUS_TX_DS));
+    CHECK(replay.getSentPackages() == 1);
+
+    replay.rewind();
+    CHECK(replay.step());
+    CHECK(replay.getTimestamp() != 0);
+}
+
+TEST_CASE("", "[RF24_Replay]") {
+    static uint8_t stream[256];
+    xXx::RF24_CaptureRecord_t record = {};
+
+    // A corrupt record claims more bytes than the RX FIFO holds
+    record.numBytes = rxFifoSize + 1;
+    memcpy(stream, &record, sizeof(record));
+
+    xXx::RF24_Replay replay(stream, sizeof(stream));
+
+    CHECK_FALSE(replay.step());
+}
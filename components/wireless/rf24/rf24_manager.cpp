@@ -0,0 +1,133 @@
+#define LOG_MODULE RF24
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <xXx/components/wireless/rf24/rf24.hpp>
+#include <xXx/components/wireless/rf24/rf24_manager.hpp>
+#include <xXx/utils/logging.hpp>
+
+#define __BOUNCE(expression, statement) \
+    if (expression) return (statement)
+
+namespace xXx {
+
+RF24_Manager::RF24_Manager(RF24_Clock_t clock)
+    : clock(clock), statisticsStart(clock()) {
+    LOG_DEBUG("%s: %p\n", __FUNCTION__, this);
+}
+
+RF24_Manager::~RF24_Manager() {
+    LOG_DEBUG("%s: %p\n", __FUNCTION__, this);
+}
+
+RF24_Manager::Entry *RF24_Manager::findEntry(RF24 &radio) {
+    for (size_t i = 0; i < numRadios; i++) {
+        __BOUNCE(radios[i].radio == &radio, &radios[i]);
+    }
+
+    return (NULL);
+}
+
+void RF24_Manager::loop() {
+    uint32_t passStart = clock();
+
+    // Radios are sorted by priority. Each one is served until it is idle or
+    // its batch is used up, so its SPI transactions are not interleaved with
+    // the other radios and the bus is never touched from two places.
+    for (size_t i = 0; i < numRadios; i++) {
+        Entry &entry = radios[i];
+
+        if (!entry.radio->hasPendingEvents()) continue;
+
+        for (uint8_t batch = 0; batch < maxBatch; batch++) {
+            entry.radio->loop();
+            entry.statistics.servicedEvents++;
+
+            if (!entry.radio->hasPendingEvents()) break;
+        }
+
+        uint32_t latency = clock() - passStart;
+
+        entry.statistics.lastLatency = latency;
+        if (latency > entry.statistics.maxLatency) entry.statistics.maxLatency = latency;
+    }
+}
+
+RF24_Status RF24_Manager::addRadio(RF24 &radio, uint8_t priority) {
+    __BOUNCE(numRadios >= maxRadios, RF24_Status::Failure);
+    __BOUNCE(findEntry(radio) != NULL, RF24_Status::Failure);
+
+    // Insert behind all radios with the same or a higher priority
+    size_t position = numRadios;
+
+    while (position > 0 && radios[position - 1].priority < priority) {
+        radios[position] = radios[position - 1];
+        position--;
+    }
+
+    radios[position]                 = Entry();
+    radios[position].radio           = &radio;
+    radios[position].priority        = priority;
+    radios[position].spiTransactions = radio.getSpiTransactions();
+    radios[position].spiBytes        = radio.getSpiBytes();
+
+    numRadios++;
+
+    return (RF24_Status::Success);
+}
+
+RF24_Status RF24_Manager::spreadChannels(uint8_t firstChannel, uint8_t spacing) {
+    __BOUNCE(numRadios == 0, RF24_Status::Success);
+    __BOUNCE(firstChannel + (numRadios - 1) * spacing > 127, RF24_Status::UnknownChannel);
+
+    for (size_t i = 0; i < numRadios; i++) {
+        RF24_Status status = radios[i].radio->setChannel(firstChannel + i * spacing);
+        __BOUNCE(status != RF24_Status::Success, status);
+    }
+
+    return (RF24_Status::Success);
+}
+
+RF24_Status RF24_Manager::getRadioStatistics(RF24 &radio, RF24_RadioStatistics_t &statistics) {
+    Entry *entry = findEntry(radio);
+
+    __BOUNCE(entry == NULL, RF24_Status::Failure);
+
+    statistics                 = entry->statistics;
+    statistics.spiTransactions = radio.getSpiTransactions() - entry->spiTransactions;
+    statistics.spiBytes        = radio.getSpiBytes() - entry->spiBytes;
+
+    return (RF24_Status::Success);
+}
+
+uint16_t RF24_Manager::getBusUtilisation(uint32_t spiClockHz, uint32_t clockHz) {
+    uint64_t busBits = 0;
+    uint64_t elapsed = clock() - statisticsStart;
+
+    for (size_t i = 0; i < numRadios; i++) {
+        busBits += 8 * static_cast<uint64_t>(radios[i].radio->getSpiBytes() - radios[i].spiBytes);
+    }
+
+    __BOUNCE(elapsed == 0 || spiClockHz == 0, 0);
+
+    // Time the bus was clocking relative to the elapsed time, in permille
+    uint64_t busyTime    = (busBits * clockHz) / spiClockHz;
+    uint64_t utilisation = (busyTime * 1000) / elapsed;
+
+    __BOUNCE(utilisation > 1000, 1000);
+
+    return (utilisation);
+}
+
+void RF24_Manager::resetStatistics() {
+    statisticsStart = clock();
+
+    for (size_t i = 0; i < numRadios; i++) {
+        radios[i].statistics      = RF24_RadioStatistics_t();
+        radios[i].spiTransactions = radios[i].radio->getSpiTransactions();
+        radios[i].spiBytes        = radios[i].radio->getSpiBytes();
+    }
+}
+
+} /* namespace xXx */
@@ -0,0 +1,55 @@
+#ifndef RF24_MANAGER_HPP
+#define RF24_MANAGER_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <xXx/components/wireless/rf24/rf24.hpp>
+#include <xXx/components/wireless/rf24/rf24_types.hpp>
+
+namespace xXx {
+
+class RF24_Manager {
+   private:
+    static const size_t maxRadios = 4;
+    static const uint8_t maxBatch = 4;
+
+    struct Entry {
+        RF24 *radio;
+        uint8_t priority;
+        uint32_t spiTransactions;
+        uint32_t spiBytes;
+        RF24_RadioStatistics_t statistics;
+    };
+
+    RF24_Clock_t clock;
+
+    Entry radios[maxRadios] = {};
+    size_t numRadios        = 0;
+    uint32_t statisticsStart;
+
+    // Copy constructor
+    RF24_Manager(const RF24_Manager &other) = default;
+
+    // Copy assignment operator
+    RF24_Manager &operator=(const RF24_Manager &other) = default;
+
+    Entry *findEntry(RF24 &radio);
+
+   public:
+    RF24_Manager(RF24_Clock_t clock);
+    ~RF24_Manager();
+
+    void loop();
+
+    RF24_Status addRadio(RF24 &radio, uint8_t priority);
+    RF24_Status spreadChannels(uint8_t firstChannel, uint8_t spacing);
+
+    RF24_Status getRadioStatistics(RF24 &radio, RF24_RadioStatistics_t &statistics);
+    uint16_t getBusUtilisation(uint32_t spiClockHz, uint32_t clockHz);
+    void resetStatistics();
+};
+
+} /* namespace xXx */
+
+#endif  // RF24_MANAGER_HPP
@@ -0,0 +1,133 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "../../../thirdparty/Catch/single_include/catch.hpp"
+
+#include <xXx/components/wireless/rf24/rf24.hpp>
+#include <xXx/components/wireless/rf24/rf24_capture.hpp>
+#include <xXx/components/wireless/rf24/rf24_manager.hpp>
+#include <xXx/components/wireless/rf24/rf24_replay.hpp>
+
+static uint32_t now = 0;
+
+static uint32_t fakeClock() {
+    return (now);
+}
+
+// Delivering a package takes one time unit per byte
+static void slowReceive(RF24_DataPackage_t package, void *user) {
+    (*static_cast<int *>(user))++;
+    now += package.numBytes;
+}
+
+// Packages of the given sizes, received on pipe 1
+static size_t captureStream(uint8_t *stream, size_t streamSize, const uint8_t *sizes, size_t numSizes) {
+    static uint8_t buffer[1024];
+    const uint8_t payload[rxFifoSize] = {};
+
+    xXx::RF24_Capture capture(buffer, sizeof(buffer), fakeClock);
+
+    for (size_t i = 0; i < numSizes; i++) {
+        capture.record(false, 1, 0x40, 0, payload, sizes[i]);
+    }
+
+    return (capture.read(stream, streamSize));
+}
+
+TEST_CASE("", "[RF24_Manager]") {
+    static const uint8_t stream[1] = {};
+
+    xXx::RF24_Replay replay(stream, 0);
+    xXx::RF24 radio(replay, replay, replay);
+    RF24_RadioStatistics_t statistics;
+
+    // Far from the epoch of the clock, the first period starts with the manager
+    now = 1000000;
+
+    xXx::RF24_Manager manager(fakeClock);
+
+    uint32_t spiBytes = radio.getSpiBytes();
+
+    REQUIRE(manager.addRadio(radio, 0) == RF24_Status::Success);
+    CHECK(manager.addRadio(radio, 0) == RF24_Status::Failure);
+
+    radio.setup();
+    spiBytes = radio.getSpiBytes() - spiBytes;
+    REQUIRE(spiBytes > 0);
+
+    // At 1 MHz every byte keeps the bus busy for 8 time units of the clock
+    now += 80 * spiBytes;
+    CHECK(manager.getBusUtilisation(1000000, 1000000) == 100);
+    CHECK(manager.getBusUtilisation(0, 1000000) == 0);
+
+    manager.resetStatistics();
+    CHECK(manager.getBusUtilisation(1000000, 1000000) == 0);
+
+    REQUIRE(radio.setChannel(10) == RF24_Status::Success);
+    REQUIRE(manager.getRadioStatistics(radio, statistics) == RF24_Status::Success);
+    CHECK(statistics.spiTransactions > 0);
+
+    now += 32 * statistics.spiBytes;
+    CHECK(manager.getBusUtilisation(1000000, 1000000) == 250);
+
+    // A bus that is busier than the time allows saturates
+    CHECK(manager.getBusUtilisation(1000, 1000000) == 1000);
+}
+
+TEST_CASE("", "[RF24_Manager]") {
+    const uint8_t highSizes[] = {3, 9, 4};
+    const uint8_t lowSizes[]  = {2, 2, 2};
+
+    static uint8_t highStream[256];
+    static uint8_t lowStream[256];
+
+    size_t highStreamSize = captureStream(highStream, sizeof(highStream), highSizes, 3);
+    size_t lowStreamSize  = captureStream(lowStream, sizeof(lowStream), lowSizes, 3);
+
+    xXx::RF24_Replay highReplay(highStream, highStreamSize);
+    xXx::RF24_Replay lowReplay(lowStream, lowStreamSize);
+    xXx::RF24 high(highReplay, highReplay, highReplay);
+    xXx::RF24 low(lowReplay, lowReplay, lowReplay);
+    xXx::RF24_Manager manager(fakeClock);
+    RF24_RadioStatistics_t statistics;
+    int delivered = 0;
+
+    REQUIRE(manager.addRadio(low, 1) == RF24_Status::Success);
+    REQUIRE(manager.addRadio(high, 2) == RF24_Status::Success);
+
+    high.setup();
+    low.setup();
+    REQUIRE(high.startListening(1, slowReceive, &delivered) == RF24_Status::Success);
+    REQUIRE(low.startListening(1, slowReceive, &delivered) == RF24_Status::Success);
+
+    // Nothing pending, nothing serviced
+    manager.loop();
+    REQUIRE(manager.getRadioStatistics(high, statistics) == RF24_Status::Success);
+    CHECK(statistics.servicedEvents == 0);
+
+    for (int i = 0; i < 3; i++) {
+        REQUIRE(highReplay.step());
+        REQUIRE(lowReplay.step());
+
+        manager.loop();
+    }
+
+    CHECK(delivered == 6);
+
+    // One loop() reads the FIFO, the next delivers the package
+    REQUIRE(manager.getRadioStatistics(high, statistics) == RF24_Status::Success);
+    CHECK(statistics.servicedEvents == 6);
+    CHECK(statistics.lastLatency == 4);
+    CHECK(statistics.maxLatency == 9);
+
+    // Latencies count from the start of the pass, the low priority radio waits
+    REQUIRE(manager.getRadioStatistics(low, statistics) == RF24_Status::Success);
+    CHECK(statistics.servicedEvents == 6);
+    CHECK(statistics.lastLatency == 4 + 2);
+    CHECK(statistics.maxLatency == 9 + 2);
+
+    manager.resetStatistics();
+    REQUIRE(manager.getRadioStatistics(low, statistics) == RF24_Status::Success);
+    CHECK(statistics.servicedEvents == 0);
+    CHECK(statistics.maxLatency == 0);
+}
@@ -0,0 +1,244 @@
+#define LOG_MODULE RF24
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <xXx/components/wireless/rf24/rf24_network.hpp>
+#include <xXx/utils/logging.hpp>
+
+#define __BOUNCE(expression, statement) \
+    if (expression) return (statement)
+
+static const uint8_t bitsPerDigit = 3;
+static const uint16_t digitMask   = 0b111;
+static const uint8_t parentPipe   = 1;
+
+static inline uint16_t levelMask(uint8_t depth) {
+    return ((1 << (bitsPerDigit * depth)) - 1);
+}
+
+static inline uint8_t getDigit(uint16_t address, uint8_t level) {
+    return ((address >> (bitsPerDigit * level)) & digitMask);
+}
+
+namespace xXx {
+
+RF24_Network::RF24_Network(RF24_NetworkLink &link, uint16_t address, size_t queueDepth)
+    : link(link), address(address), txBuffer(CircularBuffer<RF24_DataPackage_t>(queueDepth)) {
+    LOG_DEBUG("%s: %p\n", __FUNCTION__, this);
+}
+
+RF24_Network::~RF24_Network() {
+    LOG_DEBUG("%s: %p\n", __FUNCTION__, this);
+}
+
+void RF24_Network::loop() {
+    // Only what is queued now, packages arriving meanwhile wait for the next
+    // call instead of keeping this one busy.
+    size_t numPackages = txBuffer.itemsAvailable();
+
+    for (size_t i = 0; i < numPackages; i++) {
+        RF24_DataPackage_t package;
+        RF24_NetworkHeader_t header;
+
+        txBuffer.pop(package);
+        memcpy(&header, package.bytes, sizeof(header));
+
+        uint16_t nextHop = getNextHop(header.destination);
+
+        if (nextHop == noAddress) {
+            statistics.droppedPackages++;
+            continue;
+        }
+
+        RF24_Status status = link.transmit(nextHop, package.bytes, package.numBytes);
+
+        if (status != RF24_Status::Success) {
+            statistics.droppedPackages++;
+        } else if (header.source == address) {
+            statistics.sentPackages++;
+        } else {
+            statistics.forwardedPackages++;
+        }
+    }
+}
+
+void RF24_Network::receive(const RF24_DataPackage_t &package) {
+    RF24_NetworkHeader_t header;
+
+    if (package.numBytes < sizeof(header)) {
+        statistics.droppedPackages++;
+        return;
+    }
+
+    memcpy(&header, package.bytes, sizeof(header));
+
+    if (header.destination == address) {
+        statistics.deliveredPackages++;
+
+        if (callback) {
+            callback(header, &package.bytes[sizeof(header)], package.numBytes - sizeof(header), user);
+        }
+
+        return;
+    }
+
+    // Store and forward, the header is updated in place
+    RF24_DataPackage_t forward = package;
+
+    header.hops++;
+    memcpy(forward.bytes, &header, sizeof(header));
+
+    if (header.hops > maxHops || !txBuffer.push(forward)) {
+        statistics.droppedPackages++;
+    }
+}
+
+RF24_Status RF24_Network::write(uint16_t destination, uint8_t type, const uint8_t *bytes, uint8_t numBytes) {
+    RF24_DataPackage_t package;
+    RF24_NetworkHeader_t header;
+
+    __BOUNCE(numBytes > maxPayloadSize, RF24_Status::Failure);
+    __BOUNCE(!isValidAddress(destination), RF24_Status::Failure);
+
+    header.source      = address;
+    header.destination = destination;
+    header.type        = type;
+    header.hops        = 0;
+
+    memcpy(package.bytes, &header, sizeof(header));
+    memcpy(&package.bytes[sizeof(header)], bytes, numBytes);
+    package.numBytes = sizeof(header) + numBytes;
+    package.pipe     = 0;
+
+    __BOUNCE(!txBuffer.push(package), RF24_Status::Failure);
+
+    return (RF24_Status::Success);
+}
+
+void RF24_Network::setCallback(RF24_NetworkCallback_t callback, void *user) {
+    this->callback = callback;
+    this->user     = user;
+}
+
+bool RF24_Network::isNeighbour(uint16_t node) {
+    __BOUNCE(address != rootAddress && node == getParent(address), true);
+    __BOUNCE(node != rootAddress && getParent(node) == address, true);
+
+    return (false);
+}
+
+RF24_Status RF24_Network::addRoute(uint16_t destination, uint16_t nextHop) {
+    __BOUNCE(!isValidAddress(destination), RF24_Status::Failure);
+    __BOUNCE(!isNeighbour(nextHop), RF24_Status::Failure);
+
+    for (size_t i = 0; i < numRoutes; i++) {
+        if (routes[i].destination == destination) {
+            routes[i].nextHop = nextHop;
+            return (RF24_Status::Success);
+        }
+    }
+
+    __BOUNCE(numRoutes >= maxRoutes, RF24_Status::Failure);
+
+    routes[numRoutes].destination = destination;
+    routes[numRoutes].nextHop     = nextHop;
+    numRoutes++;
+
+    return (RF24_Status::Success);
+}
+
+RF24_Status RF24_Network::removeRoute(uint16_t destination) {
+    for (size_t i = 0; i < numRoutes; i++) {
+        if (routes[i].destination == destination) {
+            routes[i] = routes[--numRoutes];
+            return (RF24_Status::Success);
+        }
+    }
+
+    return (RF24_Status::Failure);
+}
+
+uint16_t RF24_Network::getNextHop(uint16_t destination) {
+    __BOUNCE(!isValidAddress(destination), noAddress);
+    __BOUNCE(destination == address, noAddress);
+
+    for (size_t i = 0; i < numRoutes; i++) {
+        __BOUNCE(routes[i].destination == destination, routes[i].nextHop);
+    }
+
+    // Down the tree if the destination is below us, up the tree otherwise
+    if (isDescendant(destination, address)) {
+        return (destination & levelMask(getDepth(address) + 1));
+    }
+
+    __BOUNCE(address == rootAddress, noAddress);
+
+    return (getParent(address));
+}
+
+uint16_t RF24_Network::getAddress() {
+    return (address);
+}
+
+void RF24_Network::getStatistics(RF24_NetworkStatistics_t &statistics) {
+    statistics = this->statistics;
+}
+
+// ----- static ---------------------------------------------------------------
+
+bool RF24_Network::isValidAddress(uint16_t address) {
+    uint8_t depth = getDepth(address);
+
+    __BOUNCE(address > levelMask(maxDepth), false);
+    __BOUNCE((address & ~levelMask(depth)) != 0, false);
+
+    for (uint8_t level = 0; level < depth; level++) {
+        __BOUNCE(getDigit(address, level) > maxChildren, false);
+    }
+
+    return (true);
+}
+
+uint8_t RF24_Network::getDepth(uint16_t address) {
+    uint8_t depth = 0;
+
+    while (depth < maxDepth && getDigit(address, depth) != 0) {
+        depth++;
+    }
+
+    return (depth);
+}
+
+uint16_t RF24_Network::getParent(uint16_t address) {
+    __BOUNCE(address == rootAddress, noAddress);
+
+    return (address & levelMask(getDepth(address) - 1));
+}
+
+uint8_t RF24_Network::getChildIndex(uint16_t address) {
+    __BOUNCE(address == rootAddress, 0);
+
+    return (getDigit(address, getDepth(address) - 1));
+}
+
+bool RF24_Network::isDescendant(uint16_t address, uint16_t ancestor) {
+    uint8_t depth = getDepth(ancestor);
+
+    __BOUNCE(getDepth(address) <= depth, false);
+
+    return ((address & levelMask(depth)) == ancestor);
+}
+
+uint8_t RF24_Network::getPipe(uint16_t from, uint16_t to) {
+    // Pipe 0 is kept free for the auto acknowledgments of the sender, the
+    // parent talks to pipe 1 and the children to pipes 2 to 5.
+    if (from != rootAddress && to == getParent(from)) {
+        return (parentPipe + getChildIndex(from));
+    }
+
+    return (parentPipe);
+}
+
+} /* namespace xXx */
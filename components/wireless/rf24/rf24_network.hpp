@@ -0,0 +1,106 @@
+#ifndef RF24_NETWORK_HPP
+#define RF24_NETWORK_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <xXx/components/wireless/rf24/rf24_types.hpp>
+#include <xXx/templates/circularbuffer.hpp>
+
+namespace xXx {
+
+struct RF24_NetworkHeader_t {
+    uint16_t source;
+    uint16_t destination;
+    uint8_t type;
+    uint8_t hops;
+};
+
+struct RF24_NetworkStatistics_t {
+    uint32_t sentPackages;
+    uint32_t deliveredPackages;
+    uint32_t forwardedPackages;
+    uint32_t droppedPackages;
+};
+
+typedef void (*RF24_NetworkCallback_t)(const RF24_NetworkHeader_t &header, const uint8_t *bytes, uint8_t numBytes, void *user);
+
+/*
+ * Moves one frame to a direct neighbour (parent or child) in the tree. Backed
+ * by RF24_RadioLink on the target and by a simulation on the host.
+ */
+class RF24_NetworkLink {
+   public:
+    virtual RF24_Status transmit(uint16_t nextHop, const uint8_t *bytes, uint8_t numBytes) = 0;
+};
+
+/*
+ * Tree network on top of the RF24 pipes. An address holds one 3 bit digit
+ * per level, least significant digit first, with digits 1 to maxChildren.
+ * 0 is the root, 02 is the second child of the root, 012 is the first
+ * child of 02 and so on.
+ */
+class RF24_Network {
+   public:
+    static const uint8_t maxChildren    = 4;
+    static const uint8_t maxDepth       = 5;
+    static const uint8_t maxHops        = 2 * maxDepth;
+    static const uint8_t maxPayloadSize = rxFifoSize - sizeof(RF24_NetworkHeader_t);
+    static const uint16_t rootAddress   = 0;
+    static const uint16_t noAddress     = 0xFFFF;
+
+   private:
+    static const size_t maxRoutes = 8;
+
+    struct Route {
+        uint16_t destination;
+        uint16_t nextHop;
+    };
+
+    RF24_NetworkLink &link;
+    uint16_t address;
+    CircularBuffer<RF24_DataPackage_t> txBuffer;
+
+    Route routes[maxRoutes] = {};
+    size_t numRoutes        = 0;
+
+    RF24_NetworkCallback_t callback     = NULL;
+    void *user                          = NULL;
+    RF24_NetworkStatistics_t statistics = {};
+
+    // Copy constructor
+    RF24_Network(const RF24_Network &other) = default;
+
+    // Copy assignment operator
+    RF24_Network &operator=(const RF24_Network &other) = default;
+
+    bool isNeighbour(uint16_t node);
+
+   public:
+    RF24_Network(RF24_NetworkLink &link, uint16_t address, size_t queueDepth = 8);
+    ~RF24_Network();
+
+    void loop();
+    void receive(const RF24_DataPackage_t &package);
+
+    RF24_Status write(uint16_t destination, uint8_t type, const uint8_t *bytes, uint8_t numBytes);
+    void setCallback(RF24_NetworkCallback_t callback, void *user = NULL);
+
+    RF24_Status addRoute(uint16_t destination, uint16_t nextHop);
+    RF24_Status removeRoute(uint16_t destination);
+    uint16_t getNextHop(uint16_t destination);
+
+    uint16_t getAddress();
+    void getStatistics(RF24_NetworkStatistics_t &statistics);
+
+    static bool isValidAddress(uint16_t address);
+    static uint8_t getDepth(uint16_t address);
+    static uint16_t getParent(uint16_t address);
+    static uint8_t getChildIndex(uint16_t address);
+    static bool isDescendant(uint16_t address, uint16_t ancestor);
+    static uint8_t getPipe(uint16_t from, uint16_t to);
+};
+
+} /* namespace xXx */
+
+#endif  // RF24_NETWORK_HPP
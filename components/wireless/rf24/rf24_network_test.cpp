@@ -0,0 +1,159 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "../../../thirdparty/Catch/single_include/catch.hpp"
+
+#include <xXx/components/wireless/rf24/rf24_network.hpp>
+
+using xXx::RF24_Network;
+using xXx::RF24_NetworkHeader_t;
+using xXx::RF24_NetworkLink;
+
+static const uint16_t addresses[] = {0, 04, 014, 0214, 01214, 03, 033, 0333};
+static const size_t numberOfNodes = sizeof(addresses) / sizeof(addresses[0]);
+
+static RF24_Network *nodes[numberOfNodes];
+
+static RF24_Network *findNode(uint16_t address) {
+    for (size_t i = 0; i < numberOfNodes; i++) {
+        if (nodes[i] && nodes[i]->getAddress() == address) return (nodes[i]);
+    }
+
+    return (NULL);
+}
+
+// Hands a frame straight to the neighbour, which has to be parent or child
+class SimulatedLink : public RF24_NetworkLink {
+   public:
+    uint16_t address = 0;
+    bool onlyNeighbours = true;
+
+    RF24_Status transmit(uint16_t nextHop, const uint8_t *bytes, uint8_t numBytes) {
+        RF24_Network *node = findNode(nextHop);
+        RF24_DataPackage_t package;
+
+        if (RF24_Network::getParent(address) != nextHop && RF24_Network::getParent(nextHop) != address) {
+            onlyNeighbours = false;
+        }
+
+        if (node == NULL) return (RF24_Status::Failure);
+
+        memcpy(package.bytes, bytes, numBytes);
+        package.numBytes = numBytes;
+        package.pipe     = RF24_Network::getPipe(address, nextHop);
+
+        node->receive(package);
+
+        return (RF24_Status::Success);
+    }
+};
+
+static SimulatedLink links[numberOfNodes];
+
+struct Received {
+    RF24_NetworkHeader_t header;
+    char message[RF24_Network::maxPayloadSize + 1];
+    int count;
+};
+
+static void receive(const RF24_NetworkHeader_t &header, const uint8_t *bytes, uint8_t numBytes, void *user) {
+    Received *received = static_cast<Received *>(user);
+
+    received->header = header;
+    memcpy(received->message, bytes, numBytes);
+    received->message[numBytes] = '\0';
+    received->count++;
+}
+
+static void runNetwork(int rounds) {
+    for (int round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < numberOfNodes; i++) {
+            if (nodes[i]) nodes[i]->loop();
+        }
+    }
+}
+
+static void createNetwork() {
+    for (size_t i = 0; i < numberOfNodes; i++) {
+        links[i].address        = addresses[i];
+        links[i].onlyNeighbours = true;
+        nodes[i]                = new RF24_Network(links[i], addresses[i]);
+    }
+}
+
+static void destroyNetwork() {
+    for (size_t i = 0; i < numberOfNodes; i++) {
+        delete nodes[i];
+        nodes[i] = NULL;
+    }
+}
+
+TEST_CASE("", "[RF24_Network]") {
+    CHECK(RF24_Network::isValidAddress(01214));
+    CHECK_FALSE(RF24_Network::isValidAddress(05));
+    CHECK_FALSE(RF24_Network::isValidAddress(0101));
+
+    CHECK(RF24_Network::getParent(01214) == 0214);
+    CHECK(RF24_Network::getDepth(01214) == 4);
+    CHECK(RF24_Network::isDescendant(01214, 014));
+    CHECK_FALSE(RF24_Network::isDescendant(0333, 04));
+}
+
+TEST_CASE("", "[RF24_Network]") {
+    Received received = {};
+    const char message[] = "hello";
+
+    createNetwork();
+
+    findNode(0333)->setCallback(receive, &received);
+
+    // Up to the root and down the other branch, 7 hops
+    REQUIRE(findNode(01214)->write(0333, 7, reinterpret_cast<const uint8_t *>(message), strlen(message)) == RF24_Status::Success);
+
+    runNetwork(10);
+
+    CHECK(received.count == 1);
+    CHECK(received.header.source == 01214);
+    CHECK(received.header.type == 7);
+    CHECK(received.header.hops == 6);
+    CHECK(strcmp(received.message, message) == 0);
+
+    xXx::RF24_NetworkStatistics_t statistics;
+    findNode(0)->getStatistics(statistics);
+    CHECK(statistics.forwardedPackages == 1);
+
+    bool onlyNeighbours = true;
+
+    for (size_t i = 0; i < numberOfNodes; i++) {
+        onlyNeighbours = onlyNeighbours && links[i].onlyNeighbours;
+    }
+
+    CHECK(onlyNeighbours);
+
+    destroyNetwork();
+}
+
+TEST_CASE("", "[RF24_Network]") {
+    const uint8_t payload[RF24_Network::maxPayloadSize + 1] = {};
+
+    createNetwork();
+
+    RF24_Network &leaf = *findNode(01214);
+
+    CHECK(leaf.write(0333, 0, payload, sizeof(payload)) == RF24_Status::Failure);
+    CHECK(leaf.write(05, 0, payload, 1) == RF24_Status::Failure);
+
+    // A node that is gone drops the package at its parent
+    delete nodes[7];
+    nodes[7] = NULL;
+
+    REQUIRE(leaf.write(0333, 0, payload, 1) == RF24_Status::Success);
+
+    runNetwork(10);
+
+    xXx::RF24_NetworkStatistics_t statistics;
+    findNode(033)->getStatistics(statistics);
+    CHECK(statistics.droppedPackages == 1);
+
+    destroyNetwork();
+}
@@ -0,0 +1,67 @@
+#include <stdint.h>
+
+#include <xXx/components/wireless/rf24/rf24.hpp>
+#include <xXx/components/wireless/rf24/rf24_network.hpp>
+#include <xXx/components/wireless/rf24/rf24_radiolink.hpp>
+
+#define __BOUNCE(expression, statement) \
+    if (expression) return (statement)
+
+// Alternating bits make good addresses for the receiver's preamble detection
+static const uint8_t pipePrefixes[] = {0xC3, 0x3C, 0x33, 0xCC, 0x3E, 0xE3};
+
+static const uint8_t ackPipe = 0;
+
+namespace xXx {
+
+RF24_RadioLink::RF24_RadioLink(RF24 &radio, uint16_t networkId, uint16_t address)
+    : radio(radio), networkId(networkId), address(address) {}
+
+uint32_t RF24_RadioLink::getBaseAddress(uint16_t node) {
+    return ((static_cast<uint32_t>(networkId) << 16) | node);
+}
+
+RF24_Status RF24_RadioLink::begin(RF24_Network &network) {
+    RF24_Status status;
+
+    RF24_RxCallback_t receiveFunction = [](RF24_DataPackage_t package, void *user) {
+        static_cast<RF24_Network *>(user)->receive(package);
+    };
+
+    // Pipes 1 to 5 share their base address
+    status = radio.writeRxBaseAddress(1, getBaseAddress(address));
+    __BOUNCE(status != RF24_Status::Success, status);
+
+    for (uint8_t pipe = 1; pipe < sizeof(pipePrefixes); pipe++) {
+        status = radio.writeRxAddress(pipe, pipePrefixes[pipe]);
+        __BOUNCE(status != RF24_Status::Success, status);
+
+        radio.startListening(pipe, receiveFunction, &network);
+    }
+
+    radio.enableDataPipe(ackPipe);
+    radio.enableAutoAcknowledgment(ackPipe);
+    radio.enterRxMode();
+
+    return (RF24_Status::Success);
+}
+
+RF24_Status RF24_RadioLink::transmit(uint16_t nextHop, const uint8_t *bytes, uint8_t numBytes) {
+    uint8_t pipe         = RF24_Network::getPipe(address, nextHop);
+    uint32_t baseAddress = getBaseAddress(nextHop);
+    RF24_Status status;
+
+    // The acknowledgment comes back on pipe 0, so it gets the same address
+    radio.writeTxBaseAddress(baseAddress);
+    radio.writeTxAddress(pipePrefixes[pipe]);
+    radio.writeRxBaseAddress(ackPipe, baseAddress);
+    radio.writeRxAddress(ackPipe, pipePrefixes[pipe]);
+
+    status = radio.send(bytes, numBytes);
+
+    radio.enterRxMode();
+
+    return (status);
+}
+
+} /* namespace xXx */
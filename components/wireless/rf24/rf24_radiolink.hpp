@@ -0,0 +1,34 @@
+#ifndef RF24_RADIOLINK_HPP
+#define RF24_RADIOLINK_HPP
+
+#include <stdint.h>
+
+#include <xXx/components/wireless/rf24/rf24.hpp>
+#include <xXx/components/wireless/rf24/rf24_network.hpp>
+#include <xXx/components/wireless/rf24/rf24_types.hpp>
+
+namespace xXx {
+
+/*
+ * Connects an RF24_Network to an RF24. The base address of a node is the
+ * network id in the upper and the node address in the lower half, the
+ * address prefix selects the pipe (see RF24_Network::getPipe).
+ */
+class RF24_RadioLink : public RF24_NetworkLink {
+   private:
+    RF24 &radio;
+    uint16_t networkId;
+    uint16_t address;
+
+    uint32_t getBaseAddress(uint16_t node);
+
+   public:
+    RF24_RadioLink(RF24 &radio, uint16_t networkId, uint16_t address);
+
+    RF24_Status begin(RF24_Network &network);
+    RF24_Status transmit(uint16_t nextHop, const uint8_t *bytes, uint8_t numBytes);
+};
+
+} /* namespace xXx */
+
+#endif  // RF24_RADIOLINK_HPP
@@ -0,0 +1,143 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <xXx/components/wireless/rf24/rf24_capture.hpp>
+#include <xXx/components/wireless/rf24/rf24_replay.hpp>
+#include <xXx/utils/bitoperations.hpp>
+
+static const uint8_t commandMask  = 0b11100000;
+static const uint8_t registerMask = 0b00011111;
+static const uint8_t emptyPipe    = 0b111;
+static const uint8_t statusFlags  = STATUS_RX_DR_MASK | STATUS_TX_DS_MASK | STATUS_MAX_RT_MASK;
+
+namespace xXx {
+
+RF24_Replay::RF24_Replay(const uint8_t *stream, size_t streamSize)
+    : stream(stream), streamSize(streamSize) {}
+
+uint8_t RF24_Replay::getStatus() {
+    uint8_t pipe = fifoFull ? fifoPipe : emptyPipe;
+
+    return (OR<uint8_t>(status, LEFT<uint8_t>(pipe, STATUS_RX_P_NO)));
+}
+
+bool RF24_Replay::step() {
+    RF24_CaptureRecord_t record;
+
+    // Sent packages are part of the stream but not played back
+    do {
+        if (position + sizeof(record) > streamSize) return (false);
+
+        memcpy(&record, &stream[position], sizeof(record));
+        position += sizeof(record);
+
+        if (position + record.numBytes > streamSize) return (false);
+        if (record.numBytes > rxFifoSize) return (false);
+
+        position += record.numBytes;
+    } while (readBit<uint8_t>(record.flags, RF24_CAPTURE_TX));
+
+    memcpy(fifoBytes, &stream[position - record.numBytes], record.numBytes);
+
+    fifoNumBytes = record.numBytes;
+    fifoPipe     = AND<uint8_t>(record.flags, RF24_CAPTURE_PIPE_MASK);
+    fifoFull     = true;
+    timestamp    = record.timestamp;
+
+    setBit_eq<uint8_t>(status, STATUS_RX_DR);
+
+    if (irqCallback) irqCallback(irqUser);
+
+    return (true);
+}
+
+void RF24_Replay::rewind() {
+    position = 0;
+    fifoFull = false;
+    status   = 0;
+}
+
+uint32_t RF24_Replay::getTimestamp() {
+    return (timestamp);
+}
+
+uint32_t RF24_Replay::getSentPackages() {
+    return (sentPackages);
+}
+
+uint8_t RF24_Replay::transmit_receive(uint8_t *txBytes, uint8_t *rxBytes, size_t numBytes) {
+    // RF24_BASE transmits in place, so everything is read before it is written
+    uint8_t command  = txBytes[0];
+    uint8_t reg      = AND<uint8_t>(command, registerMask);
+    size_t dataBytes = numBytes - 1;
+
+    rxBytes[0] = getStatus();
+
+    switch (AND<uint8_t>(command, commandMask)) {
+        case static_cast<uint8_t>(RF24_Command::R_REGISTER): {
+            if (reg == static_cast<uint8_t>(RF24_Register::STATUS)) {
+                rxBytes[1] = getStatus();
+            } else {
+                memcpy(&rxBytes[1], registers[reg], dataBytes > 5 ? 5 : dataBytes);
+            }
+        } return (0);
+        case static_cast<uint8_t>(RF24_Command::W_REGISTER): {
+            if (reg == static_cast<uint8_t>(RF24_Register::STATUS)) {
+                // Interrupt flags are cleared by writing a one
+                AND_eq<uint8_t>(status, INVERT<uint8_t>(AND<uint8_t>(txBytes[1], statusFlags)));
+            } else {
+                memcpy(registers[reg], &txBytes[1], dataBytes > 5 ? 5 : dataBytes);
+            }
+        } return (0);
+    }
+
+    switch (command) {
+        case static_cast<uint8_t>(RF24_Command::R_RX_PL_WID): {
+            rxBytes[1] = fifoNumBytes;
+        } break;
+        case static_cast<uint8_t>(RF24_Command::R_RX_PAYLOAD): {
+            memcpy(&rxBytes[1], fifoBytes, dataBytes > fifoNumBytes ? fifoNumBytes : dataBytes);
+            fifoFull = false;
+        } break;
+        case static_cast<uint8_t>(RF24_Command::W_TX_PAYLOAD):
+        case static_cast<uint8_t>(RF24_Command::W_TX_PAYLOAD_NOACK): {
+            setBit_eq<uint8_t>(status, STATUS_TX_DS);
+            sentPackages++;
+        } break;
+        case static_cast<uint8_t>(RF24_Command::FLUSH_RX): {
+            fifoFull = false;
+        } break;
+        default: break;
+    }
+
+    return (0);
+}
+
+void RF24_Replay::clear() {
+    ceLevel = false;
+}
+
+bool RF24_Replay::get() {
+    return (ceLevel);
+}
+
+void RF24_Replay::set() {
+    ceLevel = true;
+}
+
+void RF24_Replay::toggle() {
+    ceLevel = !ceLevel;
+}
+
+void RF24_Replay::disableInterrupt() {
+    irqCallback = NULL;
+    irqUser     = NULL;
+}
+
+void RF24_Replay::enableInterrupt(IGpio_Callback_t cb, void *user) {
+    irqCallback = cb;
+    irqUser     = user;
+}
+
+} /* namespace xXx */
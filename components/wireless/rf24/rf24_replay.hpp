@@ -0,0 +1,66 @@
+#ifndef RF24_REPLAY_HPP
+#define RF24_REPLAY_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <xXx/components/wireless/rf24/rf24_capture.hpp>
+#include <xXx/components/wireless/rf24/rf24_types.hpp>
+#include <xXx/interfaces/igpio.hpp>
+#include <xXx/interfaces/ispi.hpp>
+
+namespace xXx {
+
+/*
+ * Stands in for the radio behind the ISpi and the IRQ/CE pins of an RF24 and
+ * plays back a stream written by RF24_Capture. Every step() puts the next
+ * received package into the RX FIFO and raises the interrupt. Sent packages
+ * are acknowledged right away.
+ */
+class RF24_Replay : public ISpi, public IGpio {
+   private:
+    const uint8_t *stream;
+    size_t streamSize;
+    size_t position = 0;
+
+    uint8_t registers[32][5] = {};
+    uint8_t status           = 0;
+    bool ceLevel             = false;
+
+    uint8_t fifoBytes[rxFifoSize] = {};
+    uint8_t fifoNumBytes          = 0;
+    uint8_t fifoPipe              = 0;
+    bool fifoFull                 = false;
+
+    uint32_t timestamp    = 0;
+    uint32_t sentPackages = 0;
+
+    IGpio_Callback_t irqCallback = NULL;
+    void *irqUser                = NULL;
+
+    uint8_t getStatus();
+
+   public:
+    RF24_Replay(const uint8_t *stream, size_t streamSize);
+
+    bool step();
+    void rewind();
+
+    uint32_t getTimestamp();
+    uint32_t getSentPackages();
+
+    /* ISpi */
+    uint8_t transmit_receive(uint8_t *txBytes, uint8_t *rxBytes, size_t numBytes);
+
+    /* IGpio */
+    void clear();
+    bool get();
+    void set();
+    void toggle();
+    void disableInterrupt();
+    void enableInterrupt(IGpio_Callback_t cb, void *user);
+};
+
+} /* namespace xXx */
+
+#endif  // RF24_REPLAY_HPP
@@ -0,0 +1,32 @@
+#include <stdint.h>
+
+#include <xXx/components/wireless/rf24/rf24.hpp>
+#include <xXx/components/wireless/rf24/rf24_rxevent.hpp>
+
+namespace xXx {
+
+RF24_RxEvent::RF24_RxEvent(ProtothreadExecutor &executor, uint32_t events)
+    : executor(executor), events(events), droppedPackages(0) {}
+
+// Runs in the task of the radio
+void RF24_RxEvent::receive(RF24_DataPackage_t package, void *user) {
+    RF24_RxEvent *self = static_cast<RF24_RxEvent *>(user);
+
+    if (!self->packages.push(package)) self->droppedPackages++;
+
+    self->executor.post(self->events);
+}
+
+RF24_Status RF24_RxEvent::startListening(RF24 &radio, uint8_t pipe) {
+    return (radio.startListening(pipe, receive, this));
+}
+
+bool RF24_RxEvent::take(RF24_DataPackage_t &package) {
+    return (packages.pop(package));
+}
+
+uint32_t RF24_RxEvent::getDroppedPackages() {
+    return (droppedPackages);
+}
+
+} /* namespace xXx */
@@ -0,0 +1,42 @@
+#ifndef RF24_RXEVENT_HPP
+#define RF24_RXEVENT_HPP
+
+#include <stdint.h>
+
+#include <xXx/components/wireless/rf24/rf24.hpp>
+#include <xXx/components/wireless/rf24/rf24_types.hpp>
+#include <xXx/os/protothread.hpp>
+#include <xXx/templates/lockfreequeue.hpp>
+
+#define rxEventDepth (4)
+
+namespace xXx {
+
+/*
+ * Hands received packages to protothreads. Passed to
+ * RF24::startListening(), it queues every package of the pipe and posts the
+ * given events to the executor:
+ *
+ *     PT_WAIT_EVENTS(rxEvents);
+ *     while (rxEvent.take(package)) ...
+ */
+class RF24_RxEvent {
+   private:
+    LockFreeQueue<RF24_DataPackage_t, rxEventDepth> packages;
+    ProtothreadExecutor &executor;
+    uint32_t events;
+    uint32_t droppedPackages;
+
+    static void receive(RF24_DataPackage_t package, void *user);
+
+   public:
+    RF24_RxEvent(ProtothreadExecutor &executor, uint32_t events);
+
+    RF24_Status startListening(RF24 &radio, uint8_t pipe);
+    bool take(RF24_DataPackage_t &package);
+    uint32_t getDroppedPackages();
+};
+
+} /* namespace xXx */
+
+#endif  // RF24_RXEVENT_HPP
@@ -7,6 +7,10 @@
 #define rxFifoSize (32)
 #define txSettling (130)
 #define rxSettling (130)
+#define rxQueueDepth (3)
+#define powerUpDelay (1500)
+#define txTimeout (70000)
+#define txPollInterval (50)
 
 struct RF24_DataPackage_t {
     uint8_t bytes[32];
@@ -14,6 +18,24 @@ struct RF24_DataPackage_t {
     uint8_t pipe;
 };
 
+struct RF24_PipeStatistics_t {
+    uint32_t receivedPackages;
+    uint32_t receivedBytes;
+    uint32_t deliveredPackages;
+    uint32_t droppedPackages;
+};
+
+struct RF24_RadioStatistics_t {
+    uint32_t servicedEvents;
+    uint32_t spiTransactions;
+    uint32_t spiBytes;
+    uint32_t lastLatency;
+    uint32_t maxLatency;
+};
+
+// Free running counter, e.g. a cycle counter or a microsecond timer
+typedef uint32_t (*RF24_Clock_t)();
+
 // typedef void (*RF24_TxCallback_t)(void *user);
 typedef void (*RF24_RxCallback_t)(RF24_DataPackage_t data, void *user);
 
@@ -39,13 +61,23 @@ enum class RF24_OutputPower : uint8_t
     PWR_0dBm
 };
 
+enum class RF24_Mode : uint8_t
+{
+    Unknown,
+    Shutdown,
+    Standby,
+    Rx,
+    Tx
+};
+
 enum class RF24_Status : uint8_t
 {
     Success,
     Failure,
     UnknownPipe,
     UnknownChannel,
-    VerificationFailed
+    VerificationFailed,
+    Timeout
 };
 
 enum class RF24_Command : uint8_t
@@ -0,0 +1,11 @@
+#ifndef RF24_CONFIG_HPP
+#define RF24_CONFIG_HPP
+
+#include <stdint.h>
+
+// The host tests replay captures, nothing has to wait for the radio
+static inline void delayUs(uint32_t us) {
+    (void)us;
+}
+
+#endif // RF24_CONFIG_HPP
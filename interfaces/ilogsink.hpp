@@ -0,0 +1,21 @@
+#ifndef ILOGSINK_HPP
+#define ILOGSINK_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace xXx {
+
+/*
+ * Output of the logging, e.g. a DMA UART, an SWO/ITM channel or a file. The
+ * bytes of a write stay untouched until the following write returns, so a
+ * DMA transfer can run straight from them.
+ */
+class ILogSink {
+   public:
+    virtual void write(const uint8_t *bytes, size_t numBytes) = 0;
+};
+
+} /* namespace xXx */
+
+#endif /* ILOGSINK_HPP */
@@ -0,0 +1,76 @@
+#include <assert.h>
+#include <stddef.h>
+
+#include <FreeRTOS.h>
+#include <message_buffer.h>
+
+#include "messagebuffer.hpp"
+
+namespace xXx {
+
+MessageBuffer::MessageBuffer(size_t size)
+    : _messageBuffer(NULL) {
+    _messageBuffer = xMessageBufferCreate(size);
+
+    assert(_messageBuffer != NULL);
+}
+
+MessageBuffer::~MessageBuffer() {
+    if (_messageBuffer) vMessageBufferDelete(_messageBuffer);
+}
+
+size_t MessageBuffer::send(const void *message, size_t length, TickType_t ticksToWait) {
+    return (xMessageBufferSend(_messageBuffer, message, length, ticksToWait));
+}
+
+size_t MessageBuffer::sendFromISR(const void *message, size_t length) {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    size_t sent;
+
+    sent = xMessageBufferSendFromISR(_messageBuffer, message, length, &higherPriorityTaskWoken);
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+
+    return (sent);
+}
+
+size_t MessageBuffer::receive(void *message, size_t length, TickType_t ticksToWait) {
+    size_t received = xMessageBufferReceive(_messageBuffer, message, length, ticksToWait);
+
+    // A message that does not fit is left in place and returns 0 without waiting
+    if (received == 0 && nextLength() > length) return (messageBufferTooSmall);
+
+    return (received);
+}
+
+size_t MessageBuffer::receiveFromISR(void *message, size_t length) {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    size_t received;
+
+    received = xMessageBufferReceiveFromISR(_messageBuffer, message, length, &higherPriorityTaskWoken);
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+
+    if (received == 0 && nextLength() > length) return (messageBufferTooSmall);
+
+    return (received);
+}
+
+size_t MessageBuffer::nextLength() {
+    return (xMessageBufferNextLengthBytes(_messageBuffer));
+}
+
+size_t MessageBuffer::spacesAvailable() {
+    return (xMessageBufferSpacesAvailable(_messageBuffer));
+}
+
+bool MessageBuffer::isEmpty() {
+    return (xMessageBufferIsEmpty(_messageBuffer) == pdTRUE);
+}
+
+// Only while no task is blocked on the buffer
+bool MessageBuffer::reset() {
+    return (xMessageBufferReset(_messageBuffer) == pdPASS);
+}
+
+} /* namespace xXx */
@@ -0,0 +1,85 @@
+#ifndef MESSAGEBUFFER_HPP_
+#define MESSAGEBUFFER_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+#include <FreeRTOS.h>
+#include <message_buffer.h>
+
+namespace xXx {
+
+/*
+ * Returned by receive() and dequeueBatch() if the next message is longer
+ * than the buffer. It stays in the message buffer, so the call fails again
+ * right away until it is read with a buffer of nextLength() bytes.
+ */
+static const size_t messageBufferTooSmall = SIZE_MAX;
+
+/*
+ * Companion of Queue for records of variable length. Every send() is one
+ * message that receive() returns as a whole, so a record only costs its
+ * length plus a size_t in the buffer and one kernel call however long it is.
+ * enqueueBatch() sends many elements as one message, dequeueBatch() takes
+ * them in one go.
+ *
+ * Like the FreeRTOS message buffers it only supports one sending and one
+ * receiving task (or ISR) at a time, several senders need a lock.
+ */
+class MessageBuffer {
+   private:
+    MessageBufferHandle_t _messageBuffer;
+
+    MessageBuffer(const MessageBuffer &other) = delete;
+    MessageBuffer &operator=(const MessageBuffer &other) = delete;
+
+   public:
+    // size in bytes, including the size_t stored with each message
+    MessageBuffer(size_t size);
+    ~MessageBuffer();
+
+    // Returns length if the message was sent or 0 if it did not fit in time
+    size_t send(const void *message, size_t length, TickType_t ticksToWait = portMAX_DELAY);
+    size_t sendFromISR(const void *message, size_t length);
+
+    // Returns the length of the message, 0 if there was none in time or messageBufferTooSmall
+    size_t receive(void *message, size_t length, TickType_t ticksToWait = portMAX_DELAY);
+    size_t receiveFromISR(void *message, size_t length);
+
+    // Length of the next message, 0 if there is none
+    size_t nextLength();
+    size_t spacesAvailable();
+    bool isEmpty();
+    bool reset();
+
+    // All or none of the elements, returns the number sent
+    template <typename TYPE>
+    size_t enqueueBatch(const TYPE *elements, size_t count, TickType_t ticksToWait = portMAX_DELAY);
+
+    // One batch, or messageBufferTooSmall if it has more than count elements
+    template <typename TYPE>
+    size_t dequeueBatch(TYPE *elements, size_t count, TickType_t ticksToWait = portMAX_DELAY);
+};
+
+template <typename TYPE>
+size_t MessageBuffer::enqueueBatch(const TYPE *elements, size_t count, TickType_t ticksToWait) {
+    static_assert(std::is_trivially_copyable<TYPE>::value, "Elements are copied as bytes");
+
+    return (send(elements, count * sizeof(TYPE), ticksToWait) / sizeof(TYPE));
+}
+
+template <typename TYPE>
+size_t MessageBuffer::dequeueBatch(TYPE *elements, size_t count, TickType_t ticksToWait) {
+    static_assert(std::is_trivially_copyable<TYPE>::value, "Elements are copied as bytes");
+
+    size_t received = receive(elements, count * sizeof(TYPE), ticksToWait);
+
+    if (received == messageBufferTooSmall) return (messageBufferTooSmall);
+
+    return (received / sizeof(TYPE));
+}
+
+} /* namespace xXx */
+
+#endif /* MESSAGEBUFFER_HPP_ */
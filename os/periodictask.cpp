@@ -0,0 +1,81 @@
+#include <assert.h>
+#include <string.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "periodictask.hpp"
+
+namespace xXx {
+
+PeriodicTask::PeriodicTask(TickType_t period)
+    : _period(period), _deadline(0), _started(false), _statistics() {
+    assert(period > 0);
+}
+
+PeriodicTask::~PeriodicTask() {}
+
+void PeriodicTask::loop() {
+    TickType_t start, end, jitter, executionTime, late;
+
+    // The first period starts when the task does
+    if (_started) {
+        vTaskDelayUntil(&_deadline, _period);
+    } else {
+        _deadline = xTaskGetTickCount();
+        _started  = true;
+    }
+
+    start = xTaskGetTickCount();
+    run();
+    end = xTaskGetTickCount();
+
+    jitter        = start - _deadline;
+    executionTime = end - start;
+    late          = end - _deadline;
+
+    taskENTER_CRITICAL();
+
+    _statistics.periods++;
+    _statistics.lastJitter        = jitter;
+    _statistics.lastExecutionTime = executionTime;
+
+    _statistics.totalExecutionTime += executionTime;
+
+    if (jitter > _statistics.maxJitter) _statistics.maxJitter = jitter;
+    if (executionTime > _statistics.maxExecutionTime) _statistics.maxExecutionTime = executionTime;
+
+    // Resynchronise to the last deadline that has passed
+    if (late >= _period) {
+        _statistics.overruns++;
+        _statistics.skippedPeriods += late / _period - 1;
+
+        _deadline += (late / _period) * _period - _period;
+    }
+
+    taskEXIT_CRITICAL();
+}
+
+void PeriodicTask::setPeriod(TickType_t period) {
+    assert(period > 0);
+
+    _period = period;
+}
+
+TickType_t PeriodicTask::getPeriod() {
+    return (_period);
+}
+
+void PeriodicTask::getStatistics(PeriodicTask_Statistics_t &statistics) {
+    taskENTER_CRITICAL();
+    statistics = _statistics;
+    taskEXIT_CRITICAL();
+}
+
+void PeriodicTask::resetStatistics() {
+    taskENTER_CRITICAL();
+    memset(&_statistics, 0, sizeof(_statistics));
+    taskEXIT_CRITICAL();
+}
+
+} /* namespace xXx */
@@ -0,0 +1,55 @@
+#ifndef PERIODICTASK_HPP_
+#define PERIODICTASK_HPP_
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "simpletask.hpp"
+
+namespace xXx {
+
+// All times in ticks
+struct PeriodicTask_Statistics_t {
+    uint32_t periods;
+    uint32_t overruns;
+    uint32_t skippedPeriods;
+    TickType_t lastExecutionTime;
+    TickType_t maxExecutionTime;
+    uint32_t totalExecutionTime;
+    TickType_t lastJitter;
+    TickType_t maxJitter;
+};
+
+/*
+ * Calls run() at a fixed rate. Deadlines are absolute (vTaskDelayUntil), so
+ * the execution time of run() does not add up to a drift. The start jitter
+ * is the delay between a deadline and the start of run(). A run that takes
+ * longer than its period is an overrun. Of the deadlines that have passed
+ * meanwhile only the last one is served, late, the others are skipped
+ * instead of being caught up in a burst.
+ */
+class PeriodicTask : public SimpleTask {
+   private:
+    TickType_t _period;
+    TickType_t _deadline;
+    bool _started;
+    PeriodicTask_Statistics_t _statistics;
+
+    void loop() final;
+    virtual void run() = 0;
+
+   protected:
+    PeriodicTask(TickType_t period);
+    virtual ~PeriodicTask();
+
+   public:
+    void setPeriod(TickType_t period);
+    TickType_t getPeriod();
+
+    void getStatistics(PeriodicTask_Statistics_t &statistics);
+    void resetStatistics();
+};
+
+} /* namespace xXx */
+
+#endif /* PERIODICTASK_HPP_ */
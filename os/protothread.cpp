@@ -0,0 +1,113 @@
+#include <stdint.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "protothread.hpp"
+
+namespace xXx {
+
+bool Protothread::delayElapsed() {
+    TickType_t late = xTaskGetTickCount() - _wakeTime;
+
+    // Wraps like the tick count, so the wake time may lie on either side
+    return (late < (portMAX_DELAY >> 1));
+}
+
+// Takes the awaited events, others stay for the other threads
+bool Protothread::takeEvents() {
+    _receivedEvents = _executor->_events & _waitEvents;
+    _executor->_events &= ~_receivedEvents;
+
+    return (_receivedEvents != 0);
+}
+
+void ProtothreadExecutor::setup() {}
+
+void ProtothreadExecutor::loop() {
+    TickType_t timeout = portMAX_DELAY;
+    TickType_t remaining;
+    Protothread *started;
+
+    // Only this task walks _threads, other tasks hand threads over in _started
+    taskENTER_CRITICAL();
+    started  = _started;
+    _started = NULL;
+    taskEXIT_CRITICAL();
+
+    while (started != NULL) {
+        Protothread *thread = started;
+
+        started       = thread->_next;
+        thread->_next = _threads;
+        _threads      = thread;
+    }
+
+    for (Protothread **link = &_threads; *link != NULL;) {
+        Protothread *thread = *link;
+
+        switch (thread->run()) {
+            case Protothread_State::Finished: {
+                *link         = thread->_next;
+                thread->_next = NULL;
+
+                taskENTER_CRITICAL();
+                thread->_executor = NULL;
+                taskEXIT_CRITICAL();
+                continue;
+            }
+            case Protothread_State::Ready: {
+                timeout = 0;
+                break;
+            }
+            case Protothread_State::Polling: {
+                if (timeout > PROTOTHREAD_POLL_TICKS) timeout = PROTOTHREAD_POLL_TICKS;
+                break;
+            }
+            case Protothread_State::Delayed: {
+                remaining = thread->delayElapsed() ? 0 : thread->_wakeTime - xTaskGetTickCount();
+                if (timeout > remaining) timeout = remaining;
+                break;
+            }
+            case Protothread_State::Events: break;
+        }
+
+        link = &thread->_next;
+    }
+
+    _events |= waitAny(UINT32_MAX, timeout);
+    _events &= ~protothreadStartEvent;
+}
+
+bool ProtothreadExecutor::start(Protothread &thread) {
+    taskENTER_CRITICAL();
+
+    // Linking it twice would turn the list into a cycle
+    if (thread._executor != NULL) {
+        taskEXIT_CRITICAL();
+        return (false);
+    }
+
+    thread._executor = this;
+    thread._pt       = 0;
+    thread._next     = _started;
+
+    _started = &thread;
+
+    taskEXIT_CRITICAL();
+
+    // Before create() there is no task to wake, loop() finds the thread anyway
+    if (getHandle() != NULL) notify(protothreadStartEvent);
+
+    return (true);
+}
+
+void ProtothreadExecutor::post(uint32_t events) {
+    notify(events);
+}
+
+void ProtothreadExecutor::postFromISR(uint32_t events) {
+    notifyFromISR(events);
+}
+
+} /* namespace xXx */
@@ -0,0 +1,144 @@
+#ifndef PROTOTHREAD_HPP_
+#define PROTOTHREAD_HPP_
+
+#include <stdint.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "simpletask.hpp"
+
+// How often conditions without an event (PT_WAIT_UNTIL) are checked again
+#ifndef PROTOTHREAD_POLL_TICKS
+#define PROTOTHREAD_POLL_TICKS 1
+#endif
+
+// ----- Macros ---------------------------------------------------------------
+
+/*
+ * Stackless threads (A. Dunkels' protothreads) inside Protothread::run():
+ *
+ *     Protothread_State run() {
+ *         PT_BEGIN();
+ *
+ *         for (;;) {
+ *             PT_WAIT_EVENTS(buttonEvent);
+ *             PT_DELAY(debounceTicks);
+ *         }
+ *
+ *         PT_END();
+ *     }
+ *
+ * run() returns at every wait and continues behind it on the next call, so
+ * local variables do not survive a wait (use members) and a wait must not be
+ * placed inside a switch statement.
+ */
+
+#define PT_BEGIN() \
+    switch (_pt) { \
+        case 0:
+
+#define PT_END()                              \
+    }                                         \
+    _pt = 0;                                  \
+    return (xXx::Protothread_State::Finished)
+
+#define __PT_WAIT(state, condition)           \
+    do {                                      \
+        _pt = __LINE__;                       \
+        __attribute__((fallthrough));         \
+        case __LINE__:                        \
+            if (!(condition)) return (state); \
+    } while (0)
+
+#define PT_YIELD()                              \
+    do {                                        \
+        _pt = __LINE__;                         \
+        return (xXx::Protothread_State::Ready); \
+        case __LINE__:;                         \
+    } while (0)
+
+#define PT_WAIT_UNTIL(condition) __PT_WAIT(xXx::Protothread_State::Polling, condition)
+
+#define PT_DELAY(ticks)                                             \
+    do {                                                            \
+        _wakeTime = xTaskGetTickCount() + (ticks);                  \
+        __PT_WAIT(xXx::Protothread_State::Delayed, delayElapsed()); \
+    } while (0)
+
+// The bits that were set are in _receivedEvents afterwards
+#define PT_WAIT_EVENTS(bits)                                     \
+    do {                                                         \
+        _waitEvents = (bits);                                    \
+        __PT_WAIT(xXx::Protothread_State::Events, takeEvents()); \
+    } while (0)
+
+#define PT_WAIT_DEQUEUE(queue, element) PT_WAIT_UNTIL((queue).dequeue(element, 0) == pdTRUE)
+
+namespace xXx {
+
+class ProtothreadExecutor;
+
+enum class Protothread_State : uint8_t
+{
+    Ready,
+    Polling,
+    Delayed,
+    Events,
+    Finished
+};
+
+class Protothread {
+    friend class ProtothreadExecutor;
+
+   private:
+    Protothread *_next             = NULL;
+    ProtothreadExecutor *_executor = NULL;
+
+   protected:
+    uint16_t _pt             = 0;
+    TickType_t _wakeTime     = 0;
+    uint32_t _waitEvents     = 0;
+    uint32_t _receivedEvents = 0;
+
+    bool delayElapsed();
+    bool takeEvents();
+
+    virtual Protothread_State run() = 0;
+
+   public:
+    virtual ~Protothread() = default;
+};
+
+// Wakes the executor for started threads, not available to protothreads
+static const uint32_t protothreadStartEvent = 1UL << 31;
+
+/*
+ * Runs any number of protothreads on the stack of a single task. Between
+ * two passes it sleeps until the next delay ends or an event is posted,
+ * conditions without an event are polled every PROTOTHREAD_POLL_TICKS.
+ * Events are the task's notification bits 0 to 30, see
+ * SimpleTask::notify(bits).
+ */
+class ProtothreadExecutor : public SimpleTask {
+    friend class Protothread;
+
+   private:
+    Protothread *_threads = NULL;
+    Protothread *_started = NULL;
+    uint32_t _events      = 0;
+
+    void setup();
+    void loop();
+
+   public:
+    // From any task, false if the thread is running already
+    bool start(Protothread &thread);
+
+    void post(uint32_t events);
+    void postFromISR(uint32_t events);
+};
+
+} /* namespace xXx */
+
+#endif /* PROTOTHREAD_HPP_ */
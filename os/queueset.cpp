@@ -0,0 +1,96 @@
+#include <assert.h>
+#include <stdint.h>
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <semphr.h>
+
+#include "queueset.hpp"
+
+#if (configUSE_QUEUE_SETS == 1)
+
+namespace xXx {
+
+QueueSet::QueueSet(UBaseType_t length)
+    : _queueSet(NULL), _signal(NULL), _members(), _numMembers(0) {
+    // One more for the signal
+    _queueSet = xQueueCreateSet(length + 1);
+    _signal   = xSemaphoreCreateBinary();
+
+    assert(_queueSet != NULL && _signal != NULL);
+
+    xQueueAddToSet(_signal, _queueSet);
+}
+
+// Removing fails for a member that still holds elements, see QueueSet
+QueueSet::~QueueSet() {
+    BaseType_t removed;
+
+    for (uint8_t i = 0; i < _numMembers; i++) {
+        removed = xQueueRemoveFromSet(_members[i], _queueSet);
+
+        assert(removed == pdPASS);
+    }
+
+    // A pending signal is taken, so the semaphore is empty as well
+    xSemaphoreTake(_signal, 0);
+    removed = xQueueRemoveFromSet(_signal, _queueSet);
+
+    assert(removed == pdPASS);
+    (void)removed;
+
+    vSemaphoreDelete(_signal);
+    vQueueDelete(_queueSet);
+}
+
+int QueueSet::addMember(QueueSetMemberHandle_t member) {
+    BaseType_t added;
+
+    assert(_numMembers < QUEUESET_MAX_MEMBERS);
+
+    added = xQueueAddToSet(member, _queueSet);
+
+    assert(added == pdPASS);
+    (void)added;
+
+    _members[_numMembers] = member;
+
+    return (_numMembers++);
+}
+
+int QueueSet::select(TickType_t ticksToWait) {
+    QueueSetMemberHandle_t member = xQueueSelectFromSet(_queueSet, ticksToWait);
+
+    if (member == NULL) return (queueSetTimeout);
+
+    if (member == _signal) {
+        xSemaphoreTake(_signal, 0);
+        return (queueSetSignal);
+    }
+
+    for (uint8_t i = 0; i < _numMembers; i++) {
+        if (_members[i] == member) return (i);
+    }
+
+    // Only members can be selected
+    assert(false);
+
+    return (queueSetTimeout);
+}
+
+// Signals given before select() collapse into one
+void QueueSet::signal() {
+    xSemaphoreGive(_signal);
+}
+
+void QueueSet::signalFromISR() {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    xSemaphoreGiveFromISR(_signal, &higherPriorityTaskWoken);
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+} /* namespace xXx */
+
+#endif /* configUSE_QUEUE_SETS */
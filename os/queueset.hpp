@@ -0,0 +1,73 @@
+#ifndef QUEUESET_HPP_
+#define QUEUESET_HPP_
+
+#include <stdint.h>
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <semphr.h>
+
+#include "../templates/queue.hpp"
+
+#if (configUSE_QUEUE_SETS == 1)
+
+#ifndef QUEUESET_MAX_MEMBERS
+#define QUEUESET_MAX_MEMBERS 8
+#endif
+
+namespace xXx {
+
+// Returned by QueueSet::select() instead of a member index
+static const int queueSetTimeout = -1;
+static const int queueSetSignal  = -2;
+
+/*
+ * Lets one task block on several Queues at once. select() returns the index
+ * of a member that has an element, which the caller then dequeues without
+ * waiting. Each element must be dequeued after it was selected, otherwise
+ * the set and its members disagree.
+ *
+ * Task notifications cannot be part of a FreeRTOS queue set, so the set has
+ * a signal of its own: signal() wakes select() with queueSetSignal, which
+ * covers what SimpleTask::notify() would be used for otherwise.
+ *
+ * The set keeps the handles of its queues, so every queue must outlive the
+ * set and must be empty when the set is destroyed.
+ */
+class QueueSet {
+   private:
+    QueueSetHandle_t _queueSet;
+    SemaphoreHandle_t _signal;
+    QueueSetMemberHandle_t _members[QUEUESET_MAX_MEMBERS];
+    uint8_t _numMembers;
+
+    int addMember(QueueSetMemberHandle_t member);
+
+    QueueSet(const QueueSet &other) = delete;
+    QueueSet &operator=(const QueueSet &other) = delete;
+
+   public:
+    // length is the sum of the lengths of all queues that will be added
+    QueueSet(UBaseType_t length);
+    ~QueueSet();
+
+    // The queue must be empty, returns its index
+    template <typename TYPE>
+    int add(Queue<TYPE> &queue);
+
+    int select(TickType_t ticksToWait = portMAX_DELAY);
+
+    void signal();
+    void signalFromISR();
+};
+
+template <typename TYPE>
+int QueueSet::add(Queue<TYPE> &queue) {
+    return (addMember(queue._queue));
+}
+
+} /* namespace xXx */
+
+#endif /* configUSE_QUEUE_SETS */
+
+#endif /* QUEUESET_HPP_ */
@@ -1,31 +1,101 @@
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <FreeRTOS.h>
 #include <task.h>
 
+#include "../utils/trace.hpp"
 #include "simpletask.hpp"
 
 #define __INFINITE_LOOP for (;;)
 
+#ifndef SIMPLETASK_PROFILING_TIMESTAMP
+#if (configGENERATE_RUN_TIME_STATS == 1)
+#define SIMPLETASK_PROFILING_TIMESTAMP() portGET_RUN_TIME_COUNTER_VALUE()
+#else
+#define SIMPLETASK_PROFILING_TIMESTAMP() xTaskGetTickCount()
+#endif
+#endif
+
 namespace xXx {
 
+#if defined(SIMPLETASK_PROFILING)
+struct SimpleTask_Profiling {
+    SimpleTask *task;
+    SimpleTask_Profiling *next;
+    SimpleTask_Profile_t profile;
+    uint64_t totalTime;
+    uint32_t runTimeStart;
+    uint32_t taskRunTimeStart;
+};
+
+// All created tasks, newest first
+static SimpleTask_Profiling *profilings = NULL;
+#endif
+
 SimpleTask::~SimpleTask() {
     destroy();
 }
 
+void SimpleTask::taskFunction(void *simpleTask) {
+    SimpleTask *task = static_cast<SimpleTask *>(simpleTask);
+
+    task->setup();
+
+#if defined(SIMPLETASK_PROFILING)
+    task->resetProfile();
+#endif
+
+    __INFINITE_LOOP {
+        TRACE_BEGIN("task loop");
+
+#if defined(SIMPLETASK_PROFILING)
+        uint32_t start = SIMPLETASK_PROFILING_TIMESTAMP();
+        task->loop();
+        task->countIteration(SIMPLETASK_PROFILING_TIMESTAMP() - start);
+#else
+        task->loop();
+#endif
+
+        TRACE_END("task loop");
+    }
+}
+
+// The profile is registered first, the new task may run before create() returns
 void SimpleTask::create(uint16_t stackSize, uint8_t priority) {
-    auto taskFunction = [](void *simpleTask) {
-        static_cast<SimpleTask *>(simpleTask)->setup();
-        __INFINITE_LOOP static_cast<SimpleTask *>(simpleTask)->loop();
-    };
+#if defined(SIMPLETASK_PROFILING)
+    registerTask();
+#endif
 
     BaseType_t error = xTaskCreate(taskFunction, NULL, stackSize, this, priority, &_handle);
     assert(error == pdPASS);
 }
 
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+void SimpleTask::createStatic(StackType_t *stack, uint32_t stackWords, StaticTask_t *taskBuffer, uint8_t priority) {
+#if defined(SIMPLETASK_PROFILING)
+    registerTask();
+#endif
+
+    _handle = xTaskCreateStatic(taskFunction, NULL, stackWords, this, priority, stack, taskBuffer);
+    assert(_handle != NULL);
+}
+#endif
+
 void SimpleTask::destroy() {
-    vTaskDelete(_handle);
+    // vTaskDelete(NULL) would delete the calling task
+    if (_handle == NULL) return;
+
+#if defined(SIMPLETASK_PROFILING)
+    unregisterTask();
+#endif
+
+    TaskHandle_t handle = _handle;
+    _handle             = NULL;
+
+    vTaskDelete(handle);
 }
 
 void SimpleTask::notify() {
@@ -42,6 +112,56 @@ void SimpleTask::notifyFromISR() {
     }
 }
 
+void SimpleTask::notify(uint32_t bits) {
+    xTaskNotify(_handle, bits, eSetBits);
+}
+
+void SimpleTask::notifyFromISR(uint32_t bits) {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    xTaskNotifyFromISR(_handle, bits, eSetBits, &higherPriorityTaskWoken);
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+uint32_t SimpleTask::waitAny(uint32_t bits, TickType_t ticksToWait) {
+    return (waitBits(bits, false, ticksToWait));
+}
+
+uint32_t SimpleTask::waitAll(uint32_t bits, TickType_t ticksToWait) {
+    return (waitBits(bits, true, ticksToWait));
+}
+
+/*
+ * Every notification is taken as a whole and kept in _notifiedBits, so the
+ * bits nobody waits for yet are not lost for a later call.
+ */
+uint32_t SimpleTask::waitBits(uint32_t bits, bool all, TickType_t ticksToWait) {
+    TimeOut_t timeOut;
+    uint32_t received;
+    uint32_t value;
+    bool timedOut = false;
+
+    vTaskSetTimeOutState(&timeOut);
+
+    for (;;) {
+        received = _notifiedBits & bits;
+
+        if (all ? (received == bits) : (received != 0)) break;
+        if (timedOut) return (0);
+
+        if (xTaskNotifyWait(0, UINT32_MAX, &value, ticksToWait) == pdTRUE) {
+            _notifiedBits |= value;
+        }
+
+        timedOut = (xTaskCheckForTimeOut(&timeOut, &ticksToWait) == pdTRUE);
+    }
+
+    _notifiedBits &= ~received;
+
+    return (received);
+}
+
 void SimpleTask::resume() {
     vTaskResume(_handle);
 }
@@ -64,8 +184,148 @@ UBaseType_t SimpleTask::getStackHighWaterMark() {
     return (uxTaskGetStackHighWaterMark(_handle));
 }
 
+// NULL until create()
+TaskHandle_t SimpleTask::getHandle() {
+    return (_handle);
+}
+
+void SimpleTask::getProfile(SimpleTask_Profile_t &profile) {
+#if defined(SIMPLETASK_PROFILING)
+    SimpleTask_Profiling snapshot = {};
+
+    taskENTER_CRITICAL();
+
+    if (_profiling != NULL) snapshot = *_profiling;
+
+    taskEXIT_CRITICAL();
+
+    profile          = snapshot.profile;
+    profile.meanTime = profile.iterations ? snapshot.totalTime / profile.iterations : 0;
+
+#if (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_TRACE_FACILITY == 1)
+    if (snapshot.task != NULL) {
+        TaskStatus_t status;
+
+        vTaskGetInfo(_handle, &status, pdFALSE, eInvalid);
+
+        uint32_t total = portGET_RUN_TIME_COUNTER_VALUE() - snapshot.runTimeStart;
+        uint32_t own   = status.ulRunTimeCounter - snapshot.taskRunTimeStart;
+
+        profile.cpuPermille = total ? (static_cast<uint64_t>(own) * 1000) / total : 0;
+    }
+#endif
+#else
+    memset(&profile, 0, sizeof(profile));
+#endif
+
+    profile.handle = _handle;
+}
+
+// Starts a new measurement, also of the CPU share
+void SimpleTask::resetProfile() {
+#if defined(SIMPLETASK_PROFILING)
+#if (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_TRACE_FACILITY == 1)
+    TaskStatus_t status;
+
+    vTaskGetInfo(_handle, &status, pdFALSE, eInvalid);
+#endif
+
+    taskENTER_CRITICAL();
+
+    if (_profiling != NULL) {
+        memset(&_profiling->profile, 0, sizeof(_profiling->profile));
+        _profiling->totalTime = 0;
+
+#if (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_TRACE_FACILITY == 1)
+        _profiling->runTimeStart     = portGET_RUN_TIME_COUNTER_VALUE();
+        _profiling->taskRunTimeStart = status.ulRunTimeCounter;
+#endif
+    }
+
+    taskEXIT_CRITICAL();
+#endif
+}
+
+#if defined(SIMPLETASK_PROFILING)
+void SimpleTask::countIteration(uint32_t time) {
+    size_t k = 0;
+
+    while ((time >> (k + 1)) != 0 && k < taskHistogramClasses - 1) k++;
+
+    // Checked under the lock, destroy() may have freed the profile meanwhile
+    taskENTER_CRITICAL();
+
+    if (_profiling != NULL) {
+        SimpleTask_Profile_t &profile = _profiling->profile;
+
+        if (profile.iterations == 0 || time < profile.minTime) profile.minTime = time;
+        if (time > profile.maxTime) profile.maxTime = time;
+
+        profile.iterations++;
+        profile.histogram[k]++;
+        _profiling->totalTime += time;
+    }
+
+    taskEXIT_CRITICAL();
+}
+
+void SimpleTask::registerTask() {
+    SimpleTask_Profiling *profiling = new SimpleTask_Profiling();
+
+    profiling->task = this;
+
+    taskENTER_CRITICAL();
+
+    profiling->next = profilings;
+    profilings      = profiling;
+    _profiling      = profiling;
+
+    taskEXIT_CRITICAL();
+}
+
+void SimpleTask::unregisterTask() {
+    SimpleTask_Profiling *profiling;
+
+    taskENTER_CRITICAL();
+
+    profiling  = _profiling;
+    _profiling = NULL;
+
+    for (SimpleTask_Profiling **entry = &profilings; *entry != NULL; entry = &(*entry)->next) {
+        if (*entry == profiling) {
+            *entry = profiling->next;
+            break;
+        }
+    }
+
+    taskEXIT_CRITICAL();
+
+    delete profiling;
+}
+#endif
+
 // ----- static ---------------------------------------------------------------
 
+// Profiles of all created tasks, e.g. for a periodic dump
+size_t SimpleTask::getProfiles(SimpleTask_Profile_t *profiles, size_t maxProfiles) {
+    size_t numProfiles = 0;
+
+#if defined(SIMPLETASK_PROFILING)
+    vTaskSuspendAll();
+
+    for (SimpleTask_Profiling *entry = profilings; entry != NULL && numProfiles < maxProfiles; entry = entry->next) {
+        entry->task->getProfile(profiles[numProfiles++]);
+    }
+
+    xTaskResumeAll();
+#else
+    (void)profiles;
+    (void)maxProfiles;
+#endif
+
+    return (numProfiles);
+}
+
 void SimpleTask::sleep(TickType_t ticksToDelay) {
     vTaskDelay(ticksToDelay);
 }
@@ -13,30 +13,85 @@ enum Task_Priority_t {
 
 namespace xXx {
 
+/*
+ * Profile of the loop() calls of a task, collected if simpletask.cpp is
+ * built with SIMPLETASK_PROFILING. Times are measured with
+ * SIMPLETASK_PROFILING_TIMESTAMP(), by default the run time stats counter if
+ * there is one and the tick count otherwise. Histogram class k counts the
+ * times from 2^k to 2^(k+1) - 1, the last one all above.
+ */
+static const size_t taskHistogramClasses = 16;
+
+struct SimpleTask_Profile_t {
+    TaskHandle_t handle;
+    uint32_t iterations;
+    uint32_t minTime;
+    uint32_t maxTime;
+    uint32_t meanTime;
+    uint32_t histogram[taskHistogramClasses];
+    uint16_t cpuPermille;
+};
+
+// Profiling state of one task, only allocated with SIMPLETASK_PROFILING
+struct SimpleTask_Profiling;
+
 class SimpleTask {
    private:
     TaskHandle_t _handle = NULL;
     uint8_t _priority    = Task_Priority_MID;
     uint16_t _stackSize  = configMINIMAL_STACK_SIZE;
 
+    // Event bits received but not yet returned by waitAny() or waitAll()
+    uint32_t _notifiedBits = 0;
+
+    uint32_t waitBits(uint32_t bits, bool all, TickType_t ticksToWait);
+
+    // Always present so SIMPLETASK_PROFILING cannot change the layout
+    SimpleTask_Profiling *_profiling = NULL;
+
+    void countIteration(uint32_t time);
+    void registerTask();
+    void unregisterTask();
+
     virtual void setup() = 0;
     virtual void loop()  = 0;
 
+    static void taskFunction(void *simpleTask);
+
    protected:
     virtual ~SimpleTask();
 
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    void createStatic(StackType_t *stack, uint32_t stackWords, StaticTask_t *taskBuffer, uint8_t priority);
+#endif
+
    public:
     void create(uint16_t stackSize = configMINIMAL_STACK_SIZE,
                 uint8_t priority   = Task_Priority_MID);
     void destroy();
     void notify();
     void notifyFromISR();
+    void notify(uint32_t bits);
+    void notifyFromISR(uint32_t bits);
     void resume();
     void resumeFromISR();
     void suspend();
 
+    /*
+     * Event bits share the task notification with notify() and wait(), a
+     * task uses either the bits or the counting form. Only the task itself
+     * may wait. Both return the bits they have taken, 0 on timeout.
+     */
+    uint32_t waitAny(uint32_t bits, TickType_t ticksToWait = portMAX_DELAY);
+    uint32_t waitAll(uint32_t bits, TickType_t ticksToWait = portMAX_DELAY);
+
     UBaseType_t getStackHighWaterMark();
+    TaskHandle_t getHandle();
+
+    void getProfile(SimpleTask_Profile_t &profile);
+    void resetProfile();
 
+    static size_t getProfiles(SimpleTask_Profile_t *profiles, size_t maxProfiles);
     static void sleep(TickType_t ticksToDelay);
     static void wait();
 };
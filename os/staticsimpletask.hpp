@@ -0,0 +1,42 @@
+#ifndef STATICSIMPLETASK_HPP_
+#define STATICSIMPLETASK_HPP_
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "simpletask.hpp"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace xXx {
+
+/*
+ * SimpleTask whose stack and TCB are part of the object, so the RAM shows up
+ * at link time and creating the task never touches the heap. A global
+ * instance is constant initialised, create() is all that is left at boot.
+ */
+template <uint32_t STACK_WORDS>
+class StaticSimpleTask : public SimpleTask {
+    static_assert(STACK_WORDS >= configMINIMAL_STACK_SIZE, "STACK_WORDS is below configMINIMAL_STACK_SIZE");
+
+   private:
+    StackType_t _stack[STACK_WORDS];
+    StaticTask_t _taskBuffer;
+
+   protected:
+    constexpr StaticSimpleTask()
+        : _stack(), _taskBuffer() {}
+
+    virtual ~StaticSimpleTask() = default;
+
+   public:
+    void create(uint8_t priority = Task_Priority_MID) {
+        createStatic(_stack, STACK_WORDS, &_taskBuffer, priority);
+    }
+};
+
+} /* namespace xXx */
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif /* STATICSIMPLETASK_HPP_ */
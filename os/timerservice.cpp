@@ -0,0 +1,88 @@
+#include <stdint.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "timerservice.hpp"
+
+namespace xXx {
+
+void TimerService::setup() {}
+
+void TimerService::loop() {
+    TimerWheel_Node *timer;
+    TimerWheel_Callback_t callback;
+    void *user;
+    uint32_t armed;
+
+    taskENTER_CRITICAL();
+    armed = _wheel.timersArmed();
+    taskEXIT_CRITICAL();
+
+    // Until the next tick, or until the first timer is armed
+    ulTaskNotifyTake(pdTRUE, armed ? 1 : portMAX_DELAY);
+
+    for (;;) {
+        taskENTER_CRITICAL();
+
+        // An idle wheel stops and is set to the tick count by arm()
+        if (_wheel.timersArmed() == 0 || _wheel.getTime() == xTaskGetTickCount()) {
+            taskEXIT_CRITICAL();
+            break;
+        }
+
+        _wheel.tick();
+
+        taskEXIT_CRITICAL();
+
+        for (;;) {
+            taskENTER_CRITICAL();
+
+            timer = _wheel.popExpired();
+
+            if (timer) {
+                callback = timer->callback;
+                user     = timer->user;
+            }
+
+            taskEXIT_CRITICAL();
+
+            if (timer == NULL) break;
+
+            callback(user);
+        }
+    }
+}
+
+void TimerService::arm(TimerWheel_Node &timer, TickType_t delay, TimerWheel_Callback_t callback, void *user) {
+    TickType_t now = xTaskGetTickCount();
+
+    taskENTER_CRITICAL();
+
+    // An idle wheel has not followed the ticks, a busy one may lag a little
+    if (_wheel.timersArmed() == 0) _wheel.setTime(now);
+
+    _wheel.arm(timer, delay + (now - _wheel.getTime()), callback, user);
+
+    taskEXIT_CRITICAL();
+
+    notify();
+}
+
+void TimerService::cancel(TimerWheel_Node &timer) {
+    taskENTER_CRITICAL();
+    _wheel.cancel(timer);
+    taskEXIT_CRITICAL();
+}
+
+bool TimerService::isArmed(TimerWheel_Node &timer) {
+    bool armed;
+
+    taskENTER_CRITICAL();
+    armed = _wheel.isArmed(timer);
+    taskEXIT_CRITICAL();
+
+    return (armed);
+}
+
+} /* namespace xXx */
@@ -0,0 +1,45 @@
+#ifndef TIMERSERVICE_HPP_
+#define TIMERSERVICE_HPP_
+
+#include <stdint.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "../templates/timerwheel.hpp"
+#include "simpletask.hpp"
+
+// 4 levels of 64 slots reach 2^24 ticks, longer delays take extra turns
+#ifndef TIMERSERVICE_SLOT_BITS
+#define TIMERSERVICE_SLOT_BITS 6
+#endif
+
+#ifndef TIMERSERVICE_LEVELS
+#define TIMERSERVICE_LEVELS 4
+#endif
+
+namespace xXx {
+
+/*
+ * Runs the callbacks of any number of timers from one task. Timers are
+ * TimerWheel_Nodes owned by the caller and may be armed and cancelled from
+ * any task. The service only wakes up every tick while timers are armed and
+ * dispatches everything that expired in one batch. Callbacks run in the
+ * service task and must not block.
+ */
+class TimerService : public SimpleTask {
+   private:
+    TimerWheel<TIMERSERVICE_SLOT_BITS, TIMERSERVICE_LEVELS> _wheel;
+
+    void setup();
+    void loop();
+
+   public:
+    void arm(TimerWheel_Node &timer, TickType_t delay, TimerWheel_Callback_t callback, void *user);
+    void cancel(TimerWheel_Node &timer);
+    bool isArmed(TimerWheel_Node &timer);
+};
+
+} /* namespace xXx */
+
+#endif /* TIMERSERVICE_HPP_ */
@@ -0,0 +1,162 @@
+#include <assert.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "workerpool.hpp"
+
+namespace xXx {
+
+void WorkerPool::Worker::setup() {
+    handle = xTaskGetCurrentTaskHandle();
+}
+
+void WorkerPool::Worker::loop() {
+    WorkerPool_Job_t job;
+
+    if (pool->findJob(index, job)) {
+        pool->runJob(job);
+    } else {
+        pool->idle(index);
+    }
+}
+
+WorkerPool::WorkerPool()
+    : _numWorkers(0), _idleWorkers(0) {}
+
+void WorkerPool::create(uint8_t numWorkers, uint16_t stackSize, uint8_t priority) {
+    assert(numWorkers > 0 && numWorkers <= WORKERPOOL_MAX_WORKERS);
+
+    _numWorkers = numWorkers;
+
+    for (uint8_t i = 0; i < _numWorkers; i++) {
+        _workers[i].pool  = this;
+        _workers[i].index = i;
+        _workers[i].create(stackSize, priority);
+    }
+}
+
+/*
+ * Never fails: if the queue is full, the caller runs the job right away,
+ * which also slows down a producer that is faster than the pool.
+ */
+void WorkerPool::submit(WorkerPool_Function_t function, void *argument, WorkerPool_Group *group) {
+    WorkerPool_Job_t job = {function, argument, group};
+    int self             = currentWorker();
+    bool queued;
+
+    if (group) group->_pending.fetch_add(1, std::memory_order_relaxed);
+
+    if (self >= 0) {
+        queued = _workers[self].jobs.push(job);
+    } else {
+        queued = _injection.push(job);
+    }
+
+    if (queued) {
+        wakeup();
+    } else {
+        runJob(job);
+    }
+}
+
+// Helps with the jobs instead of only waiting for them
+void WorkerPool::join(WorkerPool_Group &group) {
+    WorkerPool_Job_t job;
+    int self = currentWorker();
+
+    group._waiter.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+    group._pending.fetch_or(WorkerPool_Group::waiting, std::memory_order_release);
+
+    // The last job of the group notifies, see runJob()
+    while (!group.done()) {
+        if (findJob(self, job)) {
+            runJob(job);
+        } else {
+            ulTaskNotifyTakeIndexed(WORKERPOOL_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+        }
+    }
+
+    group._pending.fetch_and(~WorkerPool_Group::waiting, std::memory_order_relaxed);
+}
+
+int WorkerPool::currentWorker() {
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+
+    for (uint8_t i = 0; i < _numWorkers; i++) {
+        if (_workers[i].handle == current) return (i);
+    }
+
+    return (-1);
+}
+
+bool WorkerPool::findJob(int self, WorkerPool_Job_t &job) {
+    if (self >= 0 && _workers[self].jobs.pop(job)) return (true);
+    if (_injection.pop(job)) return (true);
+
+    for (uint8_t i = 1; i <= _numWorkers; i++) {
+        uint8_t victim = (self + i) % _numWorkers;
+
+        if (victim != self && _workers[victim].jobs.steal(job)) return (true);
+    }
+
+    return (false);
+}
+
+void WorkerPool::runJob(WorkerPool_Job_t &job) {
+    WorkerPool_Group *group = job.group;
+    uint32_t pending;
+    TaskHandle_t waiter;
+
+    job.function(job.argument);
+
+    if (group == NULL) return;
+
+    // join() may return and the group be gone as soon as the count reaches
+    // zero, so the waiter is read before and only the handle is used after
+    pending = group->_pending.load(std::memory_order_acquire);
+
+    do {
+        waiter = group->_waiter.load(std::memory_order_relaxed);
+    } while (!group->_pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    if (pending == (WorkerPool_Group::waiting | 1)) xTaskNotifyGiveIndexed(waiter, WORKERPOOL_NOTIFY_INDEX);
+}
+
+// Sleeps until wakeup() picks this worker
+void WorkerPool::idle(uint8_t self) {
+    WorkerPool_Job_t job;
+    uint32_t bit = 1UL << self;
+
+    _idleWorkers.fetch_or(bit, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // A job submitted before the bit was set has not woken anybody
+    if (findJob(self, job)) {
+        _idleWorkers.fetch_and(~bit, std::memory_order_relaxed);
+        runJob(job);
+        return;
+    }
+
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+// Wakes one idle worker, if all are busy one of them finds the job anyway
+void WorkerPool::wakeup() {
+    uint32_t idleWorkers;
+    uint8_t next;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    idleWorkers = _idleWorkers.load(std::memory_order_seq_cst);
+
+    while (idleWorkers != 0) {
+        next = __builtin_ctz(idleWorkers);
+
+        if (_idleWorkers.compare_exchange_weak(idleWorkers, idleWorkers & ~(1UL << next), std::memory_order_acq_rel)) {
+            _workers[next].notify();
+            return;
+        }
+    }
+}
+
+} /* namespace xXx */
@@ -0,0 +1,121 @@
+#ifndef WORKERPOOL_HPP_
+#define WORKERPOOL_HPP_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "../templates/lockfreequeue.hpp"
+#include "../templates/workstealingdeque.hpp"
+#include "simpletask.hpp"
+
+// At most 32, one bit each in the idle mask
+#ifndef WORKERPOOL_MAX_WORKERS
+#define WORKERPOOL_MAX_WORKERS 4
+#endif
+
+/*
+ * join() blocks on this task notification index, the counting notifications
+ * of the jobs would otherwise mix with the event bits of notify(bits) and
+ * waitAny() on index 0. Needs configTASK_NOTIFICATION_ARRAY_ENTRIES above it,
+ * and no joining task may use the index for anything else.
+ */
+#ifndef WORKERPOOL_NOTIFY_INDEX
+#define WORKERPOOL_NOTIFY_INDEX 1
+#endif
+
+// Jobs per worker and jobs submitted from outside the pool, powers of two
+#ifndef WORKERPOOL_DEQUE_SIZE
+#define WORKERPOOL_DEQUE_SIZE 32
+#endif
+
+#ifndef WORKERPOOL_INJECTION_SIZE
+#define WORKERPOOL_INJECTION_SIZE 32
+#endif
+
+namespace xXx {
+
+typedef void (*WorkerPool_Function_t)(void *argument);
+
+// Counts the unfinished jobs submitted with it, see WorkerPool::join()
+class WorkerPool_Group {
+    friend class WorkerPool;
+
+   private:
+    // Set in _pending while a task waits in join()
+    static const uint32_t waiting = 0x80000000UL;
+
+    std::atomic<uint32_t> _pending;
+    std::atomic<TaskHandle_t> _waiter;
+
+   public:
+    WorkerPool_Group()
+        : _pending(0), _waiter(NULL) {}
+
+    bool done() {
+        return ((_pending.load(std::memory_order_acquire) & ~waiting) == 0);
+    }
+};
+
+struct WorkerPool_Job_t {
+    WorkerPool_Function_t function;
+    void *argument;
+    WorkerPool_Group *group;
+};
+
+/*
+ * A fixed number of SimpleTasks that run small jobs, a function and its
+ * argument, so submitting never allocates. Jobs submitted by a worker go to
+ * its own deque, all others to a shared queue. An idle worker takes from its
+ * own deque first, then from the shared queue and then steals from the
+ * other workers. Workers without work block until a job is submitted, so an
+ * idle pool costs no CPU time.
+ */
+class WorkerPool {
+    static_assert(WORKERPOOL_MAX_WORKERS <= 32, "WORKERPOOL_MAX_WORKERS must not exceed 32");
+    static_assert(WORKERPOOL_NOTIFY_INDEX < configTASK_NOTIFICATION_ARRAY_ENTRIES, "join() needs a notification index of its own");
+
+   private:
+    class Worker : public SimpleTask {
+       public:
+        WorkerPool *pool    = NULL;
+        TaskHandle_t handle = NULL;
+        uint8_t index       = 0;
+
+        WorkStealingDeque<WorkerPool_Job_t, WORKERPOOL_DEQUE_SIZE> jobs;
+
+       private:
+        void setup();
+        void loop();
+    };
+
+    Worker _workers[WORKERPOOL_MAX_WORKERS];
+    LockFreeQueue<WorkerPool_Job_t, WORKERPOOL_INJECTION_SIZE> _injection;
+    uint8_t _numWorkers;
+    std::atomic<uint32_t> _idleWorkers;
+
+    int currentWorker();
+    bool findJob(int self, WorkerPool_Job_t &job);
+    void runJob(WorkerPool_Job_t &job);
+    void idle(uint8_t self);
+    void wakeup();
+
+    WorkerPool(const WorkerPool &other) = delete;
+    WorkerPool &operator=(const WorkerPool &other) = delete;
+
+   public:
+    WorkerPool();
+
+    void create(uint8_t numWorkers, uint16_t stackSize = configMINIMAL_STACK_SIZE,
+                uint8_t priority = Task_Priority_MID);
+
+    void submit(WorkerPool_Function_t function, void *argument, WorkerPool_Group *group = NULL);
+    void join(WorkerPool_Group &group);
+};
+
+} /* namespace xXx */
+
+#endif /* WORKERPOOL_HPP_ */
@@ -0,0 +1,46 @@
+#ifndef HEAPSTATISTICS_HPP_
+#define HEAPSTATISTICS_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Statistics of operator new and delete, collected if operators.cpp is built
+ * with OPERATORS_HEAP_STATISTICS. Every allocation then carries a small
+ * header with its size. With OPERATORS_HEAP_CALLERS=<n> the first n call
+ * sites are recorded as well. Without OPERATORS_HEAP_STATISTICS all numbers
+ * stay zero.
+ */
+
+#ifndef OPERATORS_HEAP_CALLERS
+#define OPERATORS_HEAP_CALLERS 0
+#endif
+
+namespace xXx {
+
+// Class k counts the sizes from 2^k to 2^(k+1) - 1, the last one all above
+static const size_t heapHistogramClasses = 16;
+
+struct HeapStatistics_t {
+    uint32_t allocations;
+    uint32_t frees;
+    uint32_t failures;
+    size_t bytesInUse;
+    size_t highWaterMark;
+    uint32_t histogram[heapHistogramClasses];
+};
+
+struct HeapCaller_t {
+    void *caller;
+    uint32_t allocations;
+    size_t bytes;
+};
+
+void heapGetStatistics(HeapStatistics_t &statistics);
+size_t heapGetCallers(HeapCaller_t *callers, size_t maxCallers);
+void heapResetStatistics();
+void heapDumpStatistics();
+
+} /* namespace xXx */
+
+#endif /* HEAPSTATISTICS_HPP_ */
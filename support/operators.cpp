@@ -1,6 +1,16 @@
+#define LOG_MODULE SUPPORT
+
 #include <assert.h>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
 
 #include <FreeRTOS.h>
+#include <task.h>
+
+#include "../templates/blockpool.hpp"
+#include "../utils/logging.hpp"
+#include "heapstatistics.hpp"
 
 #ifdef __UNUSED
 #undef __UNUSED
@@ -8,46 +18,379 @@
 
 #define __UNUSED(x) ((void)x)
 
-void *operator new(size_t s) {
-    void *p = pvPortMalloc(s);
+/*
+ * Small allocations are served in constant time from block pools, larger
+ * ones and those that find their pools exhausted go to the RTOS heap. The
+ * number of blocks per size class is set at compile time, e.g.
+ * -DOPERATORS_POOL_BLOCKS_32=64. Without it a class takes no memory.
+ */
 
-#ifdef NDEBUG
-#warning "'new' operator may return NULL!"
-#else
-    assert(p not_eq NULL);
+#ifndef OPERATORS_POOL_BLOCKS_16
+#define OPERATORS_POOL_BLOCKS_16 0
+#endif
+
+#ifndef OPERATORS_POOL_BLOCKS_32
+#define OPERATORS_POOL_BLOCKS_32 0
+#endif
+
+#ifndef OPERATORS_POOL_BLOCKS_64
+#define OPERATORS_POOL_BLOCKS_64 0
 #endif
 
+#ifndef OPERATORS_POOL_BLOCKS_128
+#define OPERATORS_POOL_BLOCKS_128 0
+#endif
+
+static xXx::BlockPool<16, OPERATORS_POOL_BLOCKS_16> pool16;
+static xXx::BlockPool<32, OPERATORS_POOL_BLOCKS_32> pool32;
+static xXx::BlockPool<64, OPERATORS_POOL_BLOCKS_64> pool64;
+static xXx::BlockPool<128, OPERATORS_POOL_BLOCKS_128> pool128;
+
+static void *allocateBlock(size_t s) {
+    void *p = NULL;
+
+    // A request may use a bigger block if its own class is exhausted
+    if (p == NULL && s <= pool16.blockSize()) p = pool16.allocate();
+    if (p == NULL && s <= pool32.blockSize()) p = pool32.allocate();
+    if (p == NULL && s <= pool64.blockSize()) p = pool64.allocate();
+    if (p == NULL && s <= pool128.blockSize()) p = pool128.allocate();
+    if (p == NULL) p = pvPortMalloc(s);
+
     return (p);
 }
 
-void *operator new[](size_t s) {
-    void *p = pvPortMalloc(s);
+static void deallocateBlock(void *p) {
+    if (pool16.owns(p)) {
+        pool16.deallocate(p);
+    } else if (pool32.owns(p)) {
+        pool32.deallocate(p);
+    } else if (pool64.owns(p)) {
+        pool64.deallocate(p);
+    } else if (pool128.owns(p)) {
+        pool128.deallocate(p);
+    } else {
+        vPortFree(p);
+    }
+}
+
+// ----- Statistics -----------------------------------------------------------
+
+/*
+ * The pools are lock-free and may be used from interrupts, so the statistics
+ * are locked with the FROM_ISR critical sections. They only mask interrupts
+ * and are fine in tasks as well.
+ */
 
-#ifdef NDEBUG
-#warning "'new[]' operator may return NULL!"
+static xXx::HeapStatistics_t statistics;
+
+#if defined(OPERATORS_HEAP_STATISTICS)
+// Keeps the size of an allocation in front of it, with the alignment intact
+static const size_t headerSize = alignof(max_align_t);
+
+#if OPERATORS_HEAP_CALLERS > 0
+static xXx::HeapCaller_t callers[OPERATORS_HEAP_CALLERS];
+
+static void countCaller(void *caller, size_t s) {
+    for (size_t i = 0; i < OPERATORS_HEAP_CALLERS; i++) {
+        if (callers[i].caller == NULL) callers[i].caller = caller;
+
+        if (callers[i].caller == caller) {
+            callers[i].allocations++;
+            callers[i].bytes += s;
+            return;
+        }
+    }
+}
+#endif
+
+static size_t histogramClass(size_t s) {
+    size_t k = 0;
+
+    while ((s >>= 1) != 0 && k < xXx::heapHistogramClasses - 1) k++;
+
+    return (k);
+}
+
+static void countAllocation(size_t s, bool success, void *caller) {
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+    if (success) {
+        statistics.allocations++;
+        statistics.bytesInUse += s;
+        statistics.histogram[histogramClass(s)]++;
+
+        if (statistics.bytesInUse > statistics.highWaterMark) {
+            statistics.highWaterMark = statistics.bytesInUse;
+        }
+
+#if OPERATORS_HEAP_CALLERS > 0
+        countCaller(caller, s);
+#endif
+    } else {
+        statistics.failures++;
+    }
+
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    __UNUSED(caller);
+}
+
+static void countFree(size_t s) {
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+    statistics.frees++;
+    statistics.bytesInUse -= s;
+
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+#endif
+
+static void *allocate(size_t s, void *caller) {
+#if defined(OPERATORS_HEAP_STATISTICS)
+    uint8_t *p = static_cast<uint8_t *>(allocateBlock(s + headerSize));
+
+    countAllocation(s, p != NULL, caller);
+
+    if (p == NULL) return (NULL);
+
+    memcpy(p, &s, sizeof(s));
+
+    return (p + headerSize);
 #else
-    assert(p not_eq NULL);
+    __UNUSED(caller);
+
+    return (allocateBlock(s));
+#endif
+}
+
+static void deallocate(void *p) {
+#if defined(OPERATORS_HEAP_STATISTICS)
+    if (p == NULL) return;
+
+    uint8_t *block = static_cast<uint8_t *>(p) - headerSize;
+    size_t s;
+
+    memcpy(&s, block, sizeof(s));
+    countFree(s);
+
+    deallocateBlock(block);
+#else
+    deallocateBlock(p);
+#endif
+}
+
+namespace xXx {
+
+void heapGetStatistics(HeapStatistics_t &copy) {
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    copy = statistics;
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+size_t heapGetCallers(HeapCaller_t *copy, size_t maxCallers) {
+    size_t numCallers = 0;
+
+#if defined(OPERATORS_HEAP_STATISTICS) && OPERATORS_HEAP_CALLERS > 0
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+    for (size_t i = 0; i < OPERATORS_HEAP_CALLERS && numCallers < maxCallers; i++) {
+        if (callers[i].caller == NULL) break;
+
+        copy[numCallers++] = callers[i];
+    }
+
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+#else
+    __UNUSED(copy);
+    __UNUSED(maxCallers);
+#endif
+
+    return (numCallers);
+}
+
+// Starts a new period, the bytes in use stay as they are
+void heapResetStatistics() {
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+    size_t bytesInUse = statistics.bytesInUse;
+
+    memset(&statistics, 0, sizeof(statistics));
+    statistics.bytesInUse    = bytesInUse;
+    statistics.highWaterMark = bytesInUse;
+
+#if defined(OPERATORS_HEAP_STATISTICS) && OPERATORS_HEAP_CALLERS > 0
+    memset(callers, 0, sizeof(callers));
+#endif
+
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+void heapDumpStatistics() {
+    HeapStatistics_t copy;
+
+    heapGetStatistics(copy);
+
+    LOG_INFO("heap: %lu allocations, %lu frees, %lu failures, %lu bytes in use, %lu bytes peak\n",
+             static_cast<unsigned long>(copy.allocations), static_cast<unsigned long>(copy.frees),
+             static_cast<unsigned long>(copy.failures), static_cast<unsigned long>(copy.bytesInUse),
+             static_cast<unsigned long>(copy.highWaterMark));
+
+    for (size_t k = 0; k < heapHistogramClasses; k++) {
+        if (copy.histogram[k] == 0) continue;
+
+        LOG_INFO("heap: %6lu+ bytes: %lu\n", 1UL << k, static_cast<unsigned long>(copy.histogram[k]));
+    }
+
+#if defined(OPERATORS_HEAP_STATISTICS) && OPERATORS_HEAP_CALLERS > 0
+    for (size_t i = 0; i < OPERATORS_HEAP_CALLERS && callers[i].caller != NULL; i++) {
+        LOG_INFO("heap: caller %p: %lu allocations, %lu bytes\n", callers[i].caller,
+                 static_cast<unsigned long>(callers[i].allocations), static_cast<unsigned long>(callers[i].bytes));
+    }
 #endif
+}
+
+} /* namespace xXx */
+
+// ----- Operators ------------------------------------------------------------
+
+/*
+ * Without exceptions a failed allocation cannot be reported to the caller of
+ * a plain new, so it stops here instead of returning NULL. Code that can
+ * handle the failure uses new (std::nothrow).
+ */
+static void *checked(void *p) {
+    assert(p not_eq NULL);
+
+    if (p == NULL) abort();
 
     return (p);
 }
 
-void operator delete(void *p) {
-    vPortFree(p);
+void *operator new(size_t s) {
+    return (checked(allocate(s, __builtin_return_address(0))));
+}
+
+void *operator new[](size_t s) {
+    return (checked(allocate(s, __builtin_return_address(0))));
+}
+
+void *operator new(size_t s, const std::nothrow_t &) noexcept {
+    return (allocate(s, __builtin_return_address(0)));
+}
+
+void *operator new[](size_t s, const std::nothrow_t &) noexcept {
+    return (allocate(s, __builtin_return_address(0)));
+}
+
+void operator delete(void *p) noexcept {
+    deallocate(p);
 }
 
-void operator delete(void *p, size_t s) {
+void operator delete(void *p, size_t s) noexcept {
     __UNUSED(s);
 
     operator delete(p);
 }
 
-void operator delete[](void *p) {
-    vPortFree(p);
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void *p) noexcept {
+    deallocate(p);
 }
 
-void operator delete[](void *p, size_t s) {
+void operator delete[](void *p, size_t s) noexcept {
     __UNUSED(s);
 
     operator delete[](p);
 }
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+    operator delete[](p);
+}
+
+#if defined(__cpp_aligned_new)
+/*
+ * Over-aligned types (C++17). Alignments up to alignof(max_align_t) come
+ * from the pools and the heap as they are, bigger ones are cut out of a
+ * larger allocation that keeps its start right in front of the result.
+ */
+static bool isOverAligned(std::align_val_t alignment) {
+    return (static_cast<size_t>(alignment) > alignof(max_align_t));
+}
+
+static void *allocateAligned(size_t s, std::align_val_t alignment, void *caller) {
+    if (!isOverAligned(alignment)) return (allocate(s, caller));
+
+    size_t a         = static_cast<size_t>(alignment);
+    uint8_t *block   = NULL;
+    uintptr_t result = 0;
+
+    if (s > SIZE_MAX - a - sizeof(void *)) return (NULL);
+
+    block = static_cast<uint8_t *>(allocate(s + a - 1 + sizeof(void *), caller));
+    if (block == NULL) return (NULL);
+
+    result = (reinterpret_cast<uintptr_t>(block) + sizeof(void *) + a - 1) & ~(a - 1);
+    memcpy(reinterpret_cast<void *>(result - sizeof(void *)), &block, sizeof(void *));
+
+    return (reinterpret_cast<void *>(result));
+}
+
+static void deallocateAligned(void *p, std::align_val_t alignment) {
+    void *block;
+
+    if (p == NULL || !isOverAligned(alignment)) {
+        deallocate(p);
+        return;
+    }
+
+    memcpy(&block, static_cast<uint8_t *>(p) - sizeof(void *), sizeof(void *));
+    deallocate(block);
+}
+
+void *operator new(size_t s, std::align_val_t alignment) {
+    return (checked(allocateAligned(s, alignment, __builtin_return_address(0))));
+}
+
+void *operator new[](size_t s, std::align_val_t alignment) {
+    return (checked(allocateAligned(s, alignment, __builtin_return_address(0))));
+}
+
+void *operator new(size_t s, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return (allocateAligned(s, alignment, __builtin_return_address(0)));
+}
+
+void *operator new[](size_t s, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return (allocateAligned(s, alignment, __builtin_return_address(0)));
+}
+
+void operator delete(void *p, std::align_val_t alignment) noexcept {
+    deallocateAligned(p, alignment);
+}
+
+void operator delete(void *p, size_t s, std::align_val_t alignment) noexcept {
+    __UNUSED(s);
+
+    deallocateAligned(p, alignment);
+}
+
+void operator delete(void *p, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    deallocateAligned(p, alignment);
+}
+
+void operator delete[](void *p, std::align_val_t alignment) noexcept {
+    deallocateAligned(p, alignment);
+}
+
+void operator delete[](void *p, size_t s, std::align_val_t alignment) noexcept {
+    __UNUSED(s);
+
+    deallocateAligned(p, alignment);
+}
+
+void operator delete[](void *p, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    deallocateAligned(p, alignment);
+}
+#endif
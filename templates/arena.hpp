@@ -0,0 +1,160 @@
+#ifndef ARENA_HPP_
+#define ARENA_HPP_
+
+#include <assert.h>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <utility>
+
+namespace xXx {
+
+/*
+ * Monotonic allocator on a caller provided buffer: allocating bumps an
+ * offset, nothing is freed on its own. Everything after a mark is released
+ * at once by rewinding to it, see ArenaScope. Not thread safe, an arena
+ * belongs to one task.
+ */
+class Arena {
+   private:
+    uint8_t *_buffer;
+    size_t _size;
+    size_t _used;
+    size_t _highWaterMark;
+
+    Arena(const Arena &other) = delete;
+    Arena &operator=(const Arena &other) = delete;
+
+   public:
+    Arena(void *buffer, size_t size)
+        : _buffer(static_cast<uint8_t *>(buffer)), _size(size), _used(0), _highWaterMark(0) {}
+
+    // Returns NULL if the arena is exhausted
+    void *allocate(size_t numBytes, size_t alignment = alignof(max_align_t)) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(_buffer) + _used;
+        size_t padding    = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+        if (padding + numBytes > _size - _used) return (NULL);
+
+        _used += padding + numBytes;
+        if (_used > _highWaterMark) _highWaterMark = _used;
+
+        return (reinterpret_cast<void *>(address + padding));
+    }
+
+    /*
+     * Constructs an object in the arena. Its destructor is never called by
+     * the arena, so this is meant for trivially destructible types or
+     * objects that are destroyed by hand before the memory is released.
+     */
+    template <typename TYPE, typename... ARGS>
+    TYPE *create(ARGS &&... args) {
+        void *p = allocate(sizeof(TYPE), alignof(TYPE));
+
+        if (p == NULL) return (NULL);
+
+        return (new (p) TYPE(std::forward<ARGS>(args)...));
+    }
+
+    size_t mark() const {
+        return (_used);
+    }
+
+    void rewind(size_t mark) {
+        assert(mark <= _used);
+
+        _used = mark;
+    }
+
+    void reset() {
+        _used = 0;
+    }
+
+    size_t bytesUsed() const {
+        return (_used);
+    }
+
+    size_t bytesAvailable() const {
+        return (_size - _used);
+    }
+
+    size_t getHighWaterMark() const {
+        return (_highWaterMark);
+    }
+};
+
+// Releases everything allocated in the arena during its lifetime
+class ArenaScope {
+   private:
+    Arena &_arena;
+    size_t _mark;
+
+    ArenaScope(const ArenaScope &other) = delete;
+    ArenaScope &operator=(const ArenaScope &other) = delete;
+
+   public:
+    ArenaScope(Arena &arena)
+        : _arena(arena), _mark(arena.mark()) {}
+
+    ~ArenaScope() {
+        _arena.rewind(_mark);
+    }
+};
+
+/*
+ * Standard allocator on top of an arena, e.g. for a std::vector that lives
+ * for one cycle. deallocate() does nothing, the memory comes back with the
+ * arena.
+ */
+template <typename TYPE>
+class ArenaAllocator {
+    template <typename OTHER>
+    friend class ArenaAllocator;
+
+   private:
+    Arena *_arena;
+
+   public:
+    typedef TYPE value_type;
+
+    ArenaAllocator(Arena &arena)
+        : _arena(&arena) {}
+
+    template <typename OTHER>
+    ArenaAllocator(const ArenaAllocator<OTHER> &other)
+        : _arena(other._arena) {}
+
+    // Containers never check for NULL, so an exhausted arena stops here
+    // like a plain new, see support/operators.cpp
+    TYPE *allocate(size_t n) {
+        void *p = NULL;
+
+        if (n <= SIZE_MAX / sizeof(TYPE)) p = _arena->allocate(n * sizeof(TYPE), alignof(TYPE));
+
+        assert(p != NULL);
+
+        if (p == NULL) abort();
+
+        return (static_cast<TYPE *>(p));
+    }
+
+    void deallocate(TYPE *p, size_t n) {
+        (void)p;
+        (void)n;
+    }
+
+    template <typename OTHER>
+    bool operator==(const ArenaAllocator<OTHER> &other) const {
+        return (_arena == other._arena);
+    }
+
+    template <typename OTHER>
+    bool operator!=(const ArenaAllocator<OTHER> &other) const {
+        return (_arena != other._arena);
+    }
+};
+
+} /* namespace xXx */
+
+#endif /* ARENA_HPP_ */
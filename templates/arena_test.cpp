@@ -0,0 +1,69 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../thirdparty/Catch/single_include/catch.hpp"
+
+#include "arena.hpp"
+
+struct TestPoint {
+    int x;
+    int y;
+
+    TestPoint(int x, int y)
+        : x(x), y(y) {}
+};
+
+TEST_CASE("", "[Arena]") {
+    alignas(max_align_t) static uint8_t buffer[256];
+
+    xXx::Arena arena(buffer, sizeof(buffer));
+
+    uint8_t *a  = static_cast<uint8_t *>(arena.allocate(1, 1));
+    uint32_t *b = static_cast<uint32_t *>(arena.allocate(sizeof(uint32_t), alignof(uint32_t)));
+
+    REQUIRE(a == &buffer[0]);
+    REQUIRE(reinterpret_cast<uintptr_t>(b) % alignof(uint32_t) == 0);
+    CHECK(arena.bytesUsed() == 8);
+
+    size_t mark = arena.mark();
+
+    {
+        xXx::ArenaScope scope(arena);
+
+        TestPoint *point = arena.create<TestPoint>(1, 2);
+        REQUIRE(point != NULL);
+        CHECK(point->x == 1);
+        CHECK(point->y == 2);
+
+        CHECK(arena.allocate(sizeof(buffer)) == NULL);
+    }
+
+    CHECK(arena.mark() == mark);
+    CHECK(arena.getHighWaterMark() > mark);
+
+    arena.reset();
+    CHECK(arena.bytesAvailable() == sizeof(buffer));
+}
+
+TEST_CASE("", "[Arena]") {
+    alignas(max_align_t) static uint8_t buffer[1024];
+
+    xXx::Arena arena(buffer, sizeof(buffer));
+
+    {
+        xXx::ArenaScope scope(arena);
+        xXx::ArenaAllocator<int> allocator(arena);
+        std::vector<int, xXx::ArenaAllocator<int>> numbers(allocator);
+
+        for (int i = 0; i < 32; i++) {
+            numbers.push_back(i);
+        }
+
+        CHECK(numbers[31] == 31);
+        CHECK(reinterpret_cast<uint8_t *>(numbers.data()) >= buffer);
+        CHECK(reinterpret_cast<uint8_t *>(numbers.data()) < buffer + sizeof(buffer));
+    }
+
+    CHECK(arena.bytesUsed() == 0);
+}
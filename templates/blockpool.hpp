@@ -0,0 +1,127 @@
+#ifndef BLOCKPOOL_HPP_
+#define BLOCKPOOL_HPP_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace xXx {
+
+/*
+ * BLOCKS blocks of BLOCK_SIZE bytes, allocated and freed in constant time
+ * without locks, so interrupts may use the pool as well. Blocks that were
+ * never used are handed out in order, freed ones are kept on a list whose
+ * head carries a tag against the ABA problem. A zero initialised pool is
+ * ready to use before any constructor has run.
+ */
+template <size_t BLOCK_SIZE, size_t BLOCKS>
+class BlockPool {
+    static_assert(BLOCK_SIZE >= sizeof(uint16_t), "BLOCK_SIZE must hold a list index");
+    static_assert(BLOCK_SIZE % alignof(max_align_t) == 0, "BLOCK_SIZE must keep the blocks aligned");
+    static_assert(BLOCKS < UINT16_MAX, "BLOCKS must fit into a list index");
+
+   private:
+    // Index + 1 of the first free block in the low half, 0 if there is none
+    static const uint32_t indexMask = 0xFFFF;
+    static const uint32_t tagOne    = 0x10000;
+
+    alignas(max_align_t) uint8_t blocks[BLOCKS][BLOCK_SIZE];
+    std::atomic<uint32_t> freeList;
+    std::atomic<size_t> unused;
+
+    BlockPool(const BlockPool &other) = delete;
+    BlockPool &operator=(const BlockPool &other) = delete;
+
+   public:
+    constexpr BlockPool();
+
+    void *allocate();
+    void deallocate(void *block);
+    bool owns(const void *block) const;
+
+    static constexpr size_t blockSize() {
+        return (BLOCK_SIZE);
+    }
+};
+
+template <size_t BLOCK_SIZE, size_t BLOCKS>
+constexpr BlockPool<BLOCK_SIZE, BLOCKS>::BlockPool()
+    : blocks(), freeList(0), unused(0) {}
+
+template <size_t BLOCK_SIZE, size_t BLOCKS>
+void *BlockPool<BLOCK_SIZE, BLOCKS>::allocate() {
+    uint32_t head = freeList.load(std::memory_order_acquire);
+    uint16_t next;
+
+    while ((head & indexMask) != 0) {
+        uint8_t *block = blocks[(head & indexMask) - 1];
+
+        // May read a block that was taken meanwhile, then the tag has changed
+        memcpy(&next, block, sizeof(next));
+
+        if (freeList.compare_exchange_weak(head, (head & ~indexMask) | next, std::memory_order_acquire)) {
+            return (block);
+        }
+    }
+
+    size_t index = unused.load(std::memory_order_relaxed);
+
+    while (index < BLOCKS) {
+        if (unused.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+            return (blocks[index]);
+        }
+    }
+
+    return (NULL);
+}
+
+template <size_t BLOCK_SIZE, size_t BLOCKS>
+void BlockPool<BLOCK_SIZE, BLOCKS>::deallocate(void *block) {
+    uint8_t *bytes = static_cast<uint8_t *>(block);
+    uint32_t index = (bytes - &blocks[0][0]) / BLOCK_SIZE + 1;
+    uint32_t head  = freeList.load(std::memory_order_relaxed);
+    uint16_t next;
+
+    do {
+        next = head & indexMask;
+        memcpy(bytes, &next, sizeof(next));
+    } while (!freeList.compare_exchange_weak(head, ((head & ~indexMask) + tagOne) | index, std::memory_order_release,
+                                             std::memory_order_relaxed));
+}
+
+template <size_t BLOCK_SIZE, size_t BLOCKS>
+bool BlockPool<BLOCK_SIZE, BLOCKS>::owns(const void *block) const {
+    const uint8_t *bytes = static_cast<const uint8_t *>(block);
+
+    return (bytes >= &blocks[0][0] && bytes < &blocks[0][0] + sizeof(blocks));
+}
+
+// An empty pool takes no memory and never has a block
+template <size_t BLOCK_SIZE>
+class BlockPool<BLOCK_SIZE, 0> {
+   public:
+    constexpr BlockPool() {}
+
+    void *allocate() {
+        return (NULL);
+    }
+
+    void deallocate(void *block) {
+        (void)block;
+    }
+
+    bool owns(const void *block) const {
+        (void)block;
+
+        return (false);
+    }
+
+    static constexpr size_t blockSize() {
+        return (BLOCK_SIZE);
+    }
+};
+
+} /* namespace xXx */
+
+#endif /* BLOCKPOOL_HPP_ */
@@ -0,0 +1,91 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <thread>
+
+#include "../thirdparty/Catch/single_include/catch.hpp"
+
+#include "blockpool.hpp"
+
+TEST_CASE("", "[BlockPool]") {
+    const int numberOfBlocks = 8;
+
+    static xXx::BlockPool<32, numberOfBlocks> pool;
+    static xXx::BlockPool<32, 0> emptyPool;
+
+    void *blocks[numberOfBlocks];
+
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < numberOfBlocks; i++) {
+            blocks[i] = pool.allocate();
+            REQUIRE(blocks[i] != NULL);
+            CHECK(pool.owns(blocks[i]));
+
+            // Every block is usable in full and no other block overlaps it
+            memset(blocks[i], i, 32);
+        }
+
+        CHECK(pool.allocate() == NULL);
+
+        for (int i = 0; i < numberOfBlocks; i++) {
+            uint8_t *bytes = static_cast<uint8_t *>(blocks[i]);
+            CHECK(bytes[0] == i);
+            CHECK(bytes[31] == i);
+        }
+
+        for (int i = 0; i < numberOfBlocks; i++) {
+            pool.deallocate(blocks[i]);
+        }
+    }
+
+    int local;
+    CHECK_FALSE(pool.owns(&local));
+
+    CHECK(emptyPool.allocate() == NULL);
+    CHECK_FALSE(emptyPool.owns(&local));
+}
+
+TEST_CASE("", "[BlockPool]") {
+    const int numberOfThreads = 4;
+    const int rounds          = 20000;
+
+    static xXx::BlockPool<16, 16> pool;
+
+    std::thread threads[numberOfThreads];
+    bool intact[numberOfThreads];
+
+    for (int t = 0; t < numberOfThreads; t++) {
+        threads[t] = std::thread([t, &intact]() {
+            intact[t] = true;
+
+            for (int i = 0; i < rounds; i++) {
+                uint32_t *a = static_cast<uint32_t *>(pool.allocate());
+                uint32_t *b = static_cast<uint32_t *>(pool.allocate());
+
+                if (a) a[1] = (t << 16) | i;
+                if (b) b[1] = ~((t << 16) | i);
+
+                // Nobody else may have been given the same block
+                if (a) intact[t] = intact[t] && a[1] == static_cast<uint32_t>((t << 16) | i);
+                if (b) intact[t] = intact[t] && b[1] == static_cast<uint32_t>(~((t << 16) | i));
+
+                if (a) pool.deallocate(a);
+                if (b) pool.deallocate(b);
+            }
+        });
+    }
+
+    for (int t = 0; t < numberOfThreads; t++) {
+        threads[t].join();
+        CHECK(intact[t]);
+    }
+
+    // All blocks have come back
+    void *blocks[16];
+
+    for (int i = 0; i < 16; i++) {
+        blocks[i] = pool.allocate();
+        CHECK(blocks[i] != NULL);
+    }
+
+    CHECK(pool.allocate() == NULL);
+}
@@ -0,0 +1,103 @@
+#ifndef LOCKFREEQUEUE_HPP_
+#define LOCKFREEQUEUE_HPP_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace xXx {
+
+/*
+ * Bounded multi producer, multi consumer queue without locks (D. Vyukov).
+ * Every cell carries a sequence number that tells producers and consumers
+ * whose turn it is. The sequence is stored relative to the cell index, so a
+ * zero initialised queue is ready to use before any constructor has run.
+ */
+template <typename TYPE, size_t SIZE>
+class LockFreeQueue {
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "SIZE must be a power of two");
+
+   private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        TYPE element{};
+    };
+
+    Cell cells[SIZE];
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+
+    LockFreeQueue(const LockFreeQueue &other) = delete;
+    LockFreeQueue &operator=(const LockFreeQueue &other) = delete;
+
+   public:
+    constexpr LockFreeQueue();
+
+    bool push(const TYPE &element);
+    bool pop(TYPE &element);
+
+    size_t itemsAvailable();
+};
+
+template <typename TYPE, size_t SIZE>
+constexpr LockFreeQueue<TYPE, SIZE>::LockFreeQueue()
+    : cells(), head(0), tail(0) {}
+
+template <typename TYPE, size_t SIZE>
+bool LockFreeQueue<TYPE, SIZE>::push(const TYPE &element) {
+    size_t position = head.load(std::memory_order_relaxed);
+
+    for (;;) {
+        size_t index    = position & (SIZE - 1);
+        Cell &cell      = cells[index];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire) + index;
+        intptr_t delta  = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        if (delta == 0) {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.element = element;
+                cell.sequence.store(position + 1 - index, std::memory_order_release);
+
+                return (true);
+            }
+        } else if (delta < 0) {
+            return (false);
+        } else {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename TYPE, size_t SIZE>
+bool LockFreeQueue<TYPE, SIZE>::pop(TYPE &element) {
+    size_t position = tail.load(std::memory_order_relaxed);
+
+    for (;;) {
+        size_t index    = position & (SIZE - 1);
+        Cell &cell      = cells[index];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire) + index;
+        intptr_t delta  = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+        if (delta == 0) {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                element = cell.element;
+                cell.sequence.store(position + SIZE - index, std::memory_order_release);
+
+                return (true);
+            }
+        } else if (delta < 0) {
+            return (false);
+        } else {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename TYPE, size_t SIZE>
+size_t LockFreeQueue<TYPE, SIZE>::itemsAvailable() {
+    return (head.load(std::memory_order_relaxed) - tail.load(std::memory_order_relaxed));
+}
+
+} /* namespace xXx */
+
+#endif /* LOCKFREEQUEUE_HPP_ */
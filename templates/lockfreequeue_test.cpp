@@ -0,0 +1,74 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <thread>
+
+#include "../thirdparty/Catch/single_include/catch.hpp"
+
+#include "lockfreequeue.hpp"
+
+TEST_CASE("", "[LockFreeQueue]") {
+    const int numberOfElements = 8;
+
+    static xXx::LockFreeQueue<int, numberOfElements> queue;
+
+    REQUIRE(queue.itemsAvailable() == 0);
+
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < numberOfElements; i++) {
+            bool successfullyPushed = queue.push(i);
+            CHECK(successfullyPushed);
+        }
+
+        CHECK(queue.itemsAvailable() == numberOfElements);
+        CHECK(queue.push(numberOfElements) == false);
+
+        for (int i = 0; i < numberOfElements; i++) {
+            int tmp;
+            bool successfullyPopped = queue.pop(tmp);
+            CHECK(successfullyPopped);
+            CHECK(tmp == i);
+        }
+
+        int tmp;
+        CHECK(queue.pop(tmp) == false);
+        CHECK(queue.itemsAvailable() == 0);
+    }
+}
+
+TEST_CASE("", "[LockFreeQueue]") {
+    const int numberOfProducers = 4;
+    const int elementsPerProducer = 10000;
+
+    static xXx::LockFreeQueue<uint32_t, 64> queue;
+
+    std::thread producers[numberOfProducers];
+
+    for (int p = 0; p < numberOfProducers; p++) {
+        producers[p] = std::thread([p]() {
+            for (uint32_t i = 0; i < elementsPerProducer; i++) {
+                while (!queue.push((p << 16) | i)) std::this_thread::yield();
+            }
+        });
+    }
+
+    uint32_t next[numberOfProducers] = {};
+    bool inOrder = true;
+
+    for (int received = 0; received < numberOfProducers * elementsPerProducer;) {
+        uint32_t tmp;
+
+        if (!queue.pop(tmp)) continue;
+
+        // Elements of one producer arrive in the order they were pushed
+        inOrder = inOrder && (tmp & 0xFFFF) == next[tmp >> 16];
+        next[tmp >> 16]++;
+        received++;
+    }
+
+    for (int p = 0; p < numberOfProducers; p++) {
+        producers[p].join();
+        CHECK(next[p] == elementsPerProducer);
+    }
+
+    REQUIRE(inOrder);
+}
@@ -1,21 +1,27 @@
 #ifndef QUEUE_HPP_
 #define QUEUE_HPP_
 
+#include <assert.h>
+
 #include <FreeRTOS.h>
 #include <queue.h>
 #include <task.h>
 
 namespace xXx {
 
+class QueueSet;
+
 template <typename TYPE>
 class Queue {
+    friend class QueueSet;
+
    public:
     Queue(UBaseType_t size);
     ~Queue();
     BaseType_t dequeue(TYPE &element, TickType_t ticksToWait = portMAX_DELAY);
     BaseType_t dequeueFromISR(TYPE &element);
-    BaseType_t enqueue(TYPE &element, TickType_t ticksToWait = portMAX_DELAY);
-    BaseType_t enqueueFromISR(TYPE &element);
+    BaseType_t enqueue(const TYPE &element, TickType_t ticksToWait = portMAX_DELAY);
+    BaseType_t enqueueFromISR(const TYPE &element);
     UBaseType_t queueSpacesAvailable();
     UBaseType_t queueSpacesAvailableFromISR();
     BaseType_t queuePeek(TYPE &element, TickType_t ticksToWait = portMAX_DELAY);
@@ -23,35 +29,41 @@ class Queue {
     UBaseType_t queueMessagesWaiting();
     UBaseType_t queueMessagesWaitingFromISR();
 
-   private:
+   protected:
     QueueHandle_t _queue;
+
+    // For subclasses that create the queue themselves
+    constexpr Queue()
+        : _queue(NULL) {}
 };
 
 template <typename TYPE>
 Queue<TYPE>::Queue(UBaseType_t size)
     : _queue(NULL) {
     _queue = xQueueCreate(size, sizeof(TYPE));
+
+    assert(_queue != NULL);
 }
 
 template <typename TYPE>
 Queue<TYPE>::~Queue() {
-    vQueueDelete(_queue);
+    if (_queue) vQueueDelete(_queue);
 }
 
 template <typename TYPE>
-BaseType_t Queue<TYPE>::enqueue(TYPE &element, TickType_t ticksToWait) {
+BaseType_t Queue<TYPE>::enqueue(const TYPE &element, TickType_t ticksToWait) {
     return (xQueueSendToBack(_queue, &element, ticksToWait));
 }
 
 template <typename TYPE>
-BaseType_t Queue<TYPE>::enqueueFromISR(TYPE &element) {
-    BaseType_t higherPriorityTaskWoken, success;
+BaseType_t Queue<TYPE>::enqueueFromISR(const TYPE &element) {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    BaseType_t success;
 
     success = xQueueSendToBackFromISR(_queue, &element, &higherPriorityTaskWoken);
 
-    if (success) {
-        taskYIELD();
-    }
+    // Only switches if the call unblocked a task of higher priority
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
 
     return (success);
 }
@@ -63,13 +75,12 @@ BaseType_t Queue<TYPE>::dequeue(TYPE &element, TickType_t ticksToWait) {
 
 template <typename TYPE>
 BaseType_t Queue<TYPE>::dequeueFromISR(TYPE &element) {
-    BaseType_t higherPriorityTaskWoken, success;
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    BaseType_t success;
 
     success = xQueueReceiveFromISR(_queue, &element, &higherPriorityTaskWoken);
 
-    if (success) {
-        taskYIELD();
-    }
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
 
     return (success);
 }
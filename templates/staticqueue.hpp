@@ -0,0 +1,48 @@
+#ifndef STATICQUEUE_HPP_
+#define STATICQUEUE_HPP_
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <FreeRTOS.h>
+#include <queue.h>
+
+#include "queue.hpp"
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+namespace xXx {
+
+/*
+ * Queue whose storage and control block are part of the object, so the RAM
+ * shows up at link time and creating the queue never touches the heap. A
+ * global instance is constant initialised, create() has to be called before
+ * the queue is used.
+ */
+template <typename TYPE, UBaseType_t SIZE>
+class StaticQueue : public Queue<TYPE> {
+    static_assert(SIZE > 0, "SIZE must be at least 1");
+
+   private:
+    uint8_t _storage[SIZE * sizeof(TYPE)];
+    StaticQueue_t _queueBuffer;
+
+    StaticQueue(const StaticQueue &other) = delete;
+    StaticQueue &operator=(const StaticQueue &other) = delete;
+
+   public:
+    constexpr StaticQueue()
+        : Queue<TYPE>(), _storage(), _queueBuffer() {}
+
+    void create() {
+        this->_queue = xQueueCreateStatic(SIZE, sizeof(TYPE), _storage, &_queueBuffer);
+
+        assert(this->_queue != NULL);
+    }
+};
+
+} /* namespace xXx */
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+#endif /* STATICQUEUE_HPP_ */
@@ -0,0 +1,195 @@
+#ifndef TIMERWHEEL_HPP_
+#define TIMERWHEEL_HPP_
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace xXx {
+
+typedef void (*TimerWheel_Callback_t)(void *user);
+
+// Part of the object that owns the timer, so arming never allocates
+struct TimerWheel_Node {
+    TimerWheel_Node *next          = NULL;
+    TimerWheel_Node **pprev        = NULL;
+    uint32_t expiry                = 0;
+    TimerWheel_Callback_t callback = NULL;
+    void *user                     = NULL;
+};
+
+/*
+ * Hierarchical timer wheel (Varghese and Lauck). LEVELS wheels of
+ * 2^SLOT_BITS slots each, a slot of level n spans 2^(n * SLOT_BITS) ticks.
+ * A timer goes into the lowest level that reaches its expiry and moves down
+ * a level whenever the wheel below has turned once, so arming, cancelling
+ * and a tick are O(1) and every timer is moved at most LEVELS - 1 times.
+ * Delays beyond the range of the wheels are parked in the top level and
+ * placed again every turn.
+ *
+ * tick() moves the timers that expire into a list that popExpired() hands
+ * out one by one, so callbacks can run outside of any lock and cancel or
+ * arm timers themselves.
+ */
+template <size_t SLOT_BITS, size_t LEVELS>
+class TimerWheel {
+    static_assert(SLOT_BITS > 0 && LEVELS > 0 && SLOT_BITS * LEVELS <= 31, "the wheels must span less than 2^31 ticks");
+
+   private:
+    static const uint32_t slots    = 1UL << SLOT_BITS;
+    static const uint32_t slotMask = slots - 1;
+    static const uint32_t range    = 1UL << (SLOT_BITS * LEVELS);
+
+    TimerWheel_Node *wheels[LEVELS][slots];
+    TimerWheel_Node *expired;
+    uint32_t time;
+    uint32_t numArmed;
+
+    static void link(TimerWheel_Node *&head, TimerWheel_Node &node);
+    static void unlink(TimerWheel_Node &node);
+
+    void place(TimerWheel_Node &node);
+
+    TimerWheel(const TimerWheel &other) = delete;
+    TimerWheel &operator=(const TimerWheel &other) = delete;
+
+   public:
+    constexpr TimerWheel();
+
+    void arm(TimerWheel_Node &node, uint32_t delay, TimerWheel_Callback_t callback, void *user);
+    void cancel(TimerWheel_Node &node);
+    bool isArmed(const TimerWheel_Node &node) const;
+
+    void tick();
+    TimerWheel_Node *popExpired();
+
+    // Only while no timer is armed
+    void setTime(uint32_t time);
+    uint32_t getTime() const;
+    uint32_t timersArmed() const;
+};
+
+template <size_t SLOT_BITS, size_t LEVELS>
+constexpr TimerWheel<SLOT_BITS, LEVELS>::TimerWheel()
+    : wheels(), expired(NULL), time(0), numArmed(0) {}
+
+template <size_t SLOT_BITS, size_t LEVELS>
+void TimerWheel<SLOT_BITS, LEVELS>::link(TimerWheel_Node *&head, TimerWheel_Node &node) {
+    node.next  = head;
+    node.pprev = &head;
+
+    if (head) head->pprev = &node.next;
+    head = &node;
+}
+
+template <size_t SLOT_BITS, size_t LEVELS>
+void TimerWheel<SLOT_BITS, LEVELS>::unlink(TimerWheel_Node &node) {
+    *node.pprev = node.next;
+
+    if (node.next) node.next->pprev = node.pprev;
+
+    node.next  = NULL;
+    node.pprev = NULL;
+}
+
+template <size_t SLOT_BITS, size_t LEVELS>
+void TimerWheel<SLOT_BITS, LEVELS>::place(TimerWheel_Node &node) {
+    uint32_t delta  = node.expiry - time;
+    uint32_t expiry = node.expiry;
+    size_t level    = 0;
+
+    // Parked until the top level comes round again
+    if (delta >= range) expiry = time + range - 1;
+
+    while (level < LEVELS - 1 && (expiry - time) >= (1UL << (SLOT_BITS * (level + 1)))) level++;
+
+    link(wheels[level][(expiry >> (SLOT_BITS * level)) & slotMask], node);
+}
+
+template <size_t SLOT_BITS, size_t LEVELS>
+void TimerWheel<SLOT_BITS, LEVELS>::arm(TimerWheel_Node &node, uint32_t delay, TimerWheel_Callback_t callback, void *user) {
+    if (isArmed(node)) cancel(node);
+
+    // The current tick has been processed already
+    if (delay == 0) delay = 1;
+
+    node.expiry   = time + delay;
+    node.callback = callback;
+    node.user     = user;
+
+    place(node);
+    numArmed++;
+}
+
+template <size_t SLOT_BITS, size_t LEVELS>
+void TimerWheel<SLOT_BITS, LEVELS>::cancel(TimerWheel_Node &node) {
+    if (!isArmed(node)) return;
+
+    unlink(node);
+    numArmed--;
+}
+
+template <size_t SLOT_BITS, size_t LEVELS>
+bool TimerWheel<SLOT_BITS, LEVELS>::isArmed(const TimerWheel_Node &node) const {
+    return (node.pprev != NULL);
+}
+
+template <size_t SLOT_BITS, size_t LEVELS>
+void TimerWheel<SLOT_BITS, LEVELS>::tick() {
+    TimerWheel_Node *node;
+
+    time++;
+
+    // Every level whose lower wheels have just turned moves a slot down
+    for (size_t level = 1; level < LEVELS; level++) {
+        if ((time & ((1UL << (SLOT_BITS * level)) - 1)) != 0) break;
+
+        TimerWheel_Node *&slot = wheels[level][(time >> (SLOT_BITS * level)) & slotMask];
+
+        while ((node = slot) != NULL) {
+            unlink(*node);
+            place(*node);
+        }
+    }
+
+    TimerWheel_Node *&slot = wheels[0][time & slotMask];
+
+    while ((node = slot) != NULL) {
+        unlink(*node);
+        link(expired, *node);
+    }
+}
+
+// The next expired timer, it is not armed anymore when it is returned
+template <size_t SLOT_BITS, size_t LEVELS>
+TimerWheel_Node *TimerWheel<SLOT_BITS, LEVELS>::popExpired() {
+    TimerWheel_Node *node = expired;
+
+    if (node) {
+        unlink(*node);
+        numArmed--;
+    }
+
+    return (node);
+}
+
+template <size_t SLOT_BITS, size_t LEVELS>
+void TimerWheel<SLOT_BITS, LEVELS>::setTime(uint32_t time) {
+    assert(numArmed == 0);
+
+    this->time = time;
+}
+
+template <size_t SLOT_BITS, size_t LEVELS>
+uint32_t TimerWheel<SLOT_BITS, LEVELS>::getTime() const {
+    return (time);
+}
+
+template <size_t SLOT_BITS, size_t LEVELS>
+uint32_t TimerWheel<SLOT_BITS, LEVELS>::timersArmed() const {
+    return (numArmed);
+}
+
+} /* namespace xXx */
+
+#endif /* TIMERWHEEL_HPP_ */
@@ -0,0 +1,85 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "../thirdparty/Catch/single_include/catch.hpp"
+
+#include "timerwheel.hpp"
+
+static void countExpiry(void *user) {
+    (*static_cast<int *>(user))++;
+}
+
+// Ticks until all timers have expired and records when each one did
+template <typename WHEEL>
+static void run(WHEEL &wheel, uint32_t ticks, uint32_t *expiredAt, xXx::TimerWheel_Node *nodes) {
+    for (uint32_t i = 0; i < ticks; i++) {
+        xXx::TimerWheel_Node *node;
+
+        wheel.tick();
+
+        while ((node = wheel.popExpired()) != NULL) {
+            expiredAt[node - nodes] = wheel.getTime();
+            node->callback(node->user);
+        }
+    }
+}
+
+TEST_CASE("", "[TimerWheel]") {
+    const int numberOfTimers = 2000;
+
+    static xXx::TimerWheel<4, 3> wheel;
+    static xXx::TimerWheel_Node nodes[numberOfTimers];
+    static uint32_t expiredAt[numberOfTimers];
+    int expirations = 0;
+
+    wheel.setTime(1000);
+
+    // Delays across all levels and beyond the range of the wheels (4096)
+    for (int i = 0; i < numberOfTimers; i++) {
+        wheel.arm(nodes[i], 1 + i * 5, countExpiry, &expirations);
+    }
+
+    CHECK(wheel.timersArmed() == numberOfTimers);
+
+    // Every other timer is cancelled again
+    for (int i = 0; i < numberOfTimers; i += 2) {
+        wheel.cancel(nodes[i]);
+        CHECK_FALSE(wheel.isArmed(nodes[i]));
+    }
+
+    run(wheel, numberOfTimers * 5 + 1, expiredAt, nodes);
+
+    CHECK(expirations == numberOfTimers / 2);
+    CHECK(wheel.timersArmed() == 0);
+
+    bool onTime = true;
+
+    for (int i = 1; i < numberOfTimers; i += 2) {
+        onTime = onTime && expiredAt[i] == static_cast<uint32_t>(1000 + 1 + i * 5);
+    }
+
+    REQUIRE(onTime);
+}
+
+TEST_CASE("", "[TimerWheel]") {
+    static xXx::TimerWheel<4, 3> wheel;
+    static xXx::TimerWheel_Node nodes[2];
+    static uint32_t expiredAt[2];
+    int expirations = 0;
+
+    // The time wraps around meanwhile
+    wheel.setTime(UINT32_MAX - 10);
+
+    wheel.arm(nodes[0], 0, countExpiry, &expirations);
+    wheel.arm(nodes[1], 100, countExpiry, &expirations);
+
+    // Arming again moves the timer
+    wheel.arm(nodes[1], 20, countExpiry, &expirations);
+    CHECK(wheel.timersArmed() == 2);
+
+    run(wheel, 200, expiredAt, nodes);
+
+    CHECK(expirations == 2);
+    CHECK(expiredAt[0] == UINT32_MAX - 9);
+    CHECK(expiredAt[1] == 9);
+}
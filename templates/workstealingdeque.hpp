@@ -0,0 +1,112 @@
+#ifndef WORKSTEALINGDEQUE_HPP_
+#define WORKSTEALINGDEQUE_HPP_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace xXx {
+
+/*
+ * Bounded work stealing deque (Chase and Lev). The owner pushes and pops at
+ * the bottom, LIFO, which keeps its recent work hot in the cache. Any other
+ * thread steals from the top, FIFO, and takes the oldest work. Only the
+ * last element is contended, all other operations need no compare and swap
+ * on the owner's side. Positions only grow and are compared by difference,
+ * so they may wrap.
+ */
+template <typename TYPE, size_t SIZE>
+class WorkStealingDeque {
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "SIZE must be a power of two");
+
+   private:
+    TYPE elements[SIZE];
+    std::atomic<size_t> top;
+    std::atomic<size_t> bottom;
+
+    WorkStealingDeque(const WorkStealingDeque &other) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &other) = delete;
+
+   public:
+    constexpr WorkStealingDeque();
+
+    // Owner only
+    bool push(const TYPE &element);
+    bool pop(TYPE &element);
+
+    // Any thread
+    bool steal(TYPE &element);
+    size_t itemsAvailable();
+};
+
+template <typename TYPE, size_t SIZE>
+constexpr WorkStealingDeque<TYPE, SIZE>::WorkStealingDeque()
+    : elements(), top(0), bottom(0) {}
+
+template <typename TYPE, size_t SIZE>
+bool WorkStealingDeque<TYPE, SIZE>::push(const TYPE &element) {
+    size_t b = bottom.load(std::memory_order_relaxed);
+    size_t t = top.load(std::memory_order_acquire);
+
+    if (b - t >= SIZE) return (false);
+
+    elements[b & (SIZE - 1)] = element;
+
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+
+    return (true);
+}
+
+template <typename TYPE, size_t SIZE>
+bool WorkStealingDeque<TYPE, SIZE>::pop(TYPE &element) {
+    size_t b = bottom.load(std::memory_order_relaxed) - 1;
+    size_t t;
+    bool success = true;
+
+    // Claim the bottom element before looking at the thieves
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    t = top.load(std::memory_order_relaxed);
+
+    if (static_cast<intptr_t>(b - t) < 0) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return (false);
+    }
+
+    element = elements[b & (SIZE - 1)];
+
+    // The last element, a thief may want it as well
+    if (b == t) {
+        success = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return (success);
+}
+
+template <typename TYPE, size_t SIZE>
+bool WorkStealingDeque<TYPE, SIZE>::steal(TYPE &element) {
+    size_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    size_t b = bottom.load(std::memory_order_acquire);
+
+    if (static_cast<intptr_t>(b - t) <= 0) return (false);
+
+    // Read before claiming, the slot is only reused after top has moved on
+    element = elements[t & (SIZE - 1)];
+
+    return (top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed));
+}
+
+template <typename TYPE, size_t SIZE>
+size_t WorkStealingDeque<TYPE, SIZE>::itemsAvailable() {
+    size_t b = bottom.load(std::memory_order_relaxed);
+    size_t t = top.load(std::memory_order_relaxed);
+
+    return (static_cast<intptr_t>(b - t) > 0 ? b - t : 0);
+}
+
+} /* namespace xXx */
+
+#endif /* WORKSTEALINGDEQUE_HPP_ */
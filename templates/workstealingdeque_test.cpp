@@ -0,0 +1,89 @@
+#include <atomic>
+#include <stdint.h>
+#include <stdlib.h>
+#include <thread>
+
+#include "../thirdparty/Catch/single_include/catch.hpp"
+
+#include "workstealingdeque.hpp"
+
+TEST_CASE("", "[WorkStealingDeque]") {
+    const int numberOfElements = 8;
+
+    static xXx::WorkStealingDeque<int, numberOfElements> deque;
+
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < numberOfElements; i++) {
+            bool successfullyPushed = deque.push(i);
+            CHECK(successfullyPushed);
+        }
+
+        CHECK(deque.itemsAvailable() == numberOfElements);
+        CHECK(deque.push(numberOfElements) == false);
+
+        int tmp;
+
+        // The owner takes the newest, a thief the oldest
+        CHECK(deque.pop(tmp));
+        CHECK(tmp == numberOfElements - 1);
+        CHECK(deque.steal(tmp));
+        CHECK(tmp == 0);
+
+        for (int i = numberOfElements - 2; i >= 1; i--) {
+            bool successfullyPopped = deque.pop(tmp);
+            CHECK(successfullyPopped);
+            CHECK(tmp == i);
+        }
+
+        CHECK(deque.pop(tmp) == false);
+        CHECK(deque.steal(tmp) == false);
+        CHECK(deque.itemsAvailable() == 0);
+    }
+}
+
+TEST_CASE("", "[WorkStealingDeque]") {
+    const int numberOfThieves  = 3;
+    const int numberOfElements = 100000;
+
+    static xXx::WorkStealingDeque<int, 64> deque;
+    static std::atomic<uint8_t> seen[numberOfElements];
+    static std::atomic<bool> finished(false);
+
+    std::thread thieves[numberOfThieves];
+
+    for (int t = 0; t < numberOfThieves; t++) {
+        thieves[t] = std::thread([]() {
+            int tmp;
+
+            while (!finished.load()) {
+                if (deque.steal(tmp)) seen[tmp]++;
+            }
+        });
+    }
+
+    for (int i = 0; i < numberOfElements;) {
+        int tmp;
+
+        if (deque.push(i)) i++;
+        if (i % 3 == 0 && deque.pop(tmp)) seen[tmp]++;
+    }
+
+    int tmp;
+
+    while (deque.pop(tmp)) seen[tmp]++;
+
+    finished = true;
+
+    for (int t = 0; t < numberOfThieves; t++) {
+        thieves[t].join();
+    }
+
+    // Every element was taken exactly once
+    bool exactlyOnce = true;
+
+    for (int i = 0; i < numberOfElements; i++) {
+        exactlyOnce = exactlyOnce && seen[i] == 1;
+    }
+
+    REQUIRE(exactlyOnce);
+}
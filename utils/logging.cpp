@@ -1,3 +1,4 @@
+#include <atomic>
 #include <ctype.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -6,9 +7,35 @@
 #include <FreeRTOS.h>
 #include <task.h>
 
+#include "../templates/lockfreequeue.hpp"
 #include "logging.hpp"
 
-static const size_t bytesPerLine = 16;
+static const char hexDigits[]      = "0123456789abcdef";
+static const size_t maxSpecifier   = 16;
+static const TickType_t batchTicks = LOG_BATCH_TICKS;
+
+// One more for the terminating zero and one to notice that a line was cut
+struct LogLine_t {
+    uint16_t length;
+    char text[LOG_LINE_SIZE + 2];
+};
+
+static_assert(LOG_LINE_SIZE >= xXx::hexdumpLineLength, "LOG_LINE_SIZE must hold a hexdump line");
+static_assert(LOG_LINE_SIZE >= 4, "LOG_LINE_SIZE must hold the truncation marker");
+static_assert(LOG_BATCH_SIZE >= LOG_LINE_SIZE, "LOG_BATCH_SIZE must hold a line");
+
+static xXx::LockFreeQueue<xXx::LogRecord_t, LOG_DEFERRED_RECORDS> deferredRecords;
+static xXx::LockFreeQueue<LogLine_t, LOG_LINES> lines;
+static std::atomic_flag writing = ATOMIC_FLAG_INIT;
+static std::atomic<uint32_t> droppedMessages(0);
+static std::atomic<uint32_t> truncatedMessages(0);
+
+// Only touched by the task that holds the writing flag
+static uint8_t batches[2][LOG_BATCH_SIZE];
+static xXx::ILogSink *sink   = NULL;
+static size_t batchLength    = 0;
+static uint8_t activeBatch   = 0;
+static TickType_t batchStart = 0;
 
 static inline uint32_t ticks2ms(TickType_t ticks) {
     return (ticks * portTICK_PERIOD_MS);
@@ -22,60 +49,305 @@ static inline uint32_t getMilliseconds(TickType_t ticks) {
     return (ticks2ms(ticks) % 1000);
 }
 
-static inline void printTime() {
-    TickType_t ticks      = xTaskGetTickCount();
-    uint32_t seconds      = getSeconds(ticks);
-    uint32_t milliseconds = getMilliseconds(ticks);
+static inline size_t advance(size_t length, int written, size_t bufferSize) {
+    if (written < 0) return (length);
+    if (length + written >= bufferSize) return (bufferSize - 1);
 
-    printf("[%5lu.%03lu] ", seconds, milliseconds);
+    return (length + written);
 }
 
-namespace xXx {
+static inline size_t formatTime(char *buffer, size_t bufferSize, TickType_t ticks) {
+    unsigned long seconds      = getSeconds(ticks);
+    unsigned long milliseconds = getMilliseconds(ticks);
 
-void hexdump(const void *bytes, size_t numBytes) {
-    for (size_t i = 0; i < numBytes; i += bytesPerLine) {
-        printf("0x%08x:", i);
-
-        for (size_t j = i; j < (i + bytesPerLine); j++) {
-            char c;
-
-            if (j < numBytes) {
-                c = static_cast<const char *>(bytes)[j];
-                printf(" %02x", c);
-            } else {
-                printf("   ");
-            }
+    return (advance(0, snprintf(buffer, bufferSize, "[%5lu.%03lu] ", seconds, milliseconds), bufferSize));
+}
+
+// Cuts a line at LOG_LINE_SIZE, marks it and keeps the newline of its format
+static size_t truncateLine(LogLine_t &line, size_t length, const char *format) {
+    static const char marker[] = "...\n";
+    size_t formatLength        = strlen(format);
+    size_t markerLength        = sizeof(marker) - 2;
+
+    if (length <= LOG_LINE_SIZE) return (length);
+
+    if (formatLength > 0 && format[formatLength - 1] == '\n') markerLength++;
+
+    memcpy(&line.text[LOG_LINE_SIZE - markerLength], marker, markerLength);
+    truncatedMessages++;
+
+    return (LOG_LINE_SIZE);
+}
+
+static void flushBatch() {
+    if (batchLength == 0) return;
+
+    if (sink) {
+        sink->write(batches[activeBatch], batchLength);
+    } else {
+        fwrite(batches[activeBatch], 1, batchLength, stdout);
+    }
+
+    // The sink may still be reading the old buffer, fill the other one
+    activeBatch ^= 1;
+    batchLength = 0;
+}
+
+static void appendLine(const LogLine_t &line) {
+    if (batchLength + line.length > LOG_BATCH_SIZE) flushBatch();
+    if (batchLength == 0) batchStart = xTaskGetTickCount();
+
+    memcpy(&batches[activeBatch][batchLength], line.text, line.length);
+    batchLength += line.length;
+}
+
+// Writes out all queued lines. Only one task at a time does that, the
+// others leave their lines to it instead of waiting.
+static void writeLines(bool force) {
+    LogLine_t line;
+
+    do {
+        if (writing.test_and_set(std::memory_order_acquire)) return;
+
+        while (lines.pop(line)) {
+            appendLine(line);
         }
 
-        putchar(' ');
+        if (force || xTaskGetTickCount() - batchStart >= batchTicks) {
+            flushBatch();
+        }
 
-        for (size_t j = i; j < (i + bytesPerLine); j++) {
-            char c;
+        writing.clear(std::memory_order_release);
+    } while (lines.itemsAvailable() > 0);
+}
 
-            if (j < numBytes) {
-                c = static_cast<const char *>(bytes)[j];
+// Lines are committed as a whole, so they never tear or interleave
+static void commitLine(const LogLine_t &line) {
+    if (!lines.push(line)) {
+        writeLines(false);
 
-                if (not isprint(c)) {
-                    c = '.';
-                }
-            } else {
-                c = ' ';
-            }
+        if (!lines.push(line)) {
+            droppedMessages++;
+            return;
+        }
+    }
+
+    writeLines(false);
+}
+
+// One hexdump line from a lookup table, without any stdio call
+static void formatLine(char *line, const uint8_t *bytes, size_t offset, size_t numBytes) {
+    *line++ = '0';
+    *line++ = 'x';
+
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        *line++ = hexDigits[(offset >> shift) & 0xF];
+    }
+
+    *line++ = ':';
+
+    for (size_t j = offset; j < (offset + xXx::hexdumpBytesPerLine); j++) {
+        *line++ = ' ';
+
+        if (j < numBytes) {
+            *line++ = hexDigits[bytes[j] >> 4];
+            *line++ = hexDigits[bytes[j] & 0xF];
+        } else {
+            *line++ = ' ';
+            *line++ = ' ';
+        }
+    }
+
+    *line++ = ' ';
 
-            putchar(c);
+    for (size_t j = offset; j < (offset + xXx::hexdumpBytesPerLine); j++) {
+        if (j < numBytes) {
+            *line++ = isprint(bytes[j]) ? bytes[j] : '.';
+        } else {
+            *line++ = ' ';
         }
+    }
+
+    *line = '\n';
+}
+
+// Formats a single conversion with an argument of the type it asks for
+static int formatArgument(char *buffer, size_t bufferSize, const char *specifier, uint64_t argument) {
+    size_t length    = strlen(specifier);
+    char conversion  = specifier[length - 1];
+    bool isLongLong  = strstr(specifier, "ll") || strchr(specifier, 'j');
+    bool isLong      = !isLongLong && (strchr(specifier, 'l') || strchr(specifier, 'z') || strchr(specifier, 't'));
+    double floating;
+
+    switch (conversion) {
+        case 'd':
+        case 'i': {
+            if (isLongLong) return (snprintf(buffer, bufferSize, specifier, static_cast<long long>(argument)));
+            if (isLong) return (snprintf(buffer, bufferSize, specifier, static_cast<long>(argument)));
+            return (snprintf(buffer, bufferSize, specifier, static_cast<int>(argument)));
+        }
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X': {
+            if (isLongLong) return (snprintf(buffer, bufferSize, specifier, static_cast<unsigned long long>(argument)));
+            if (isLong) return (snprintf(buffer, bufferSize, specifier, static_cast<unsigned long>(argument)));
+            return (snprintf(buffer, bufferSize, specifier, static_cast<unsigned int>(argument)));
+        }
+        case 'c': return (snprintf(buffer, bufferSize, specifier, static_cast<int>(argument)));
+        case 'p': return (snprintf(buffer, bufferSize, specifier, reinterpret_cast<void *>(static_cast<uintptr_t>(argument))));
+        case 's': return (snprintf(buffer, bufferSize, specifier, reinterpret_cast<const char *>(static_cast<uintptr_t>(argument))));
+        case 'a':
+        case 'A':
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G': {
+            memcpy(&floating, &argument, sizeof(floating));
+            return (snprintf(buffer, bufferSize, specifier, floating));
+        }
+        default: return (snprintf(buffer, bufferSize, "%s", specifier));
+    }
+}
+
+namespace xXx {
 
-        putchar('\n');
+uint8_t logThreshold = LOG_LEVEL_TRACE;
+
+void hexdump(const void *bytes, size_t numBytes) {
+    LogLine_t line;
+
+    for (size_t i = 0; i < numBytes; i += hexdumpBytesPerLine) {
+        formatLine(line.text, static_cast<const uint8_t *>(bytes), i, numBytes);
+        line.length = hexdumpLineLength;
+        commitLine(line);
     }
 }
 
+size_t hexdumpFormat(char *buffer, size_t bufferSize, const void *bytes, size_t numBytes) {
+    size_t length = 0;
+
+    // Whole lines only, as many as fit
+    for (size_t i = 0; i < numBytes && length + hexdumpLineLength <= bufferSize; i += hexdumpBytesPerLine) {
+        formatLine(&buffer[length], static_cast<const uint8_t *>(bytes), i, numBytes);
+        length += hexdumpLineLength;
+    }
+
+    return (length);
+}
+
 void log(const char *format, ...) {
-    printTime();
+    LogLine_t line;
+    size_t length = formatTime(line.text, sizeof(line.text), xTaskGetTickCount());
 
     va_list arguments;
     va_start(arguments, format);
-    vprintf(format, arguments);
+    length = advance(length, vsnprintf(&line.text[length], sizeof(line.text) - length, format, arguments), sizeof(line.text));
     va_end(arguments);
+
+    line.length = truncateLine(line, length, format);
+    commitLine(line);
+}
+
+void logSetThreshold(uint8_t level) {
+    logThreshold = level;
+}
+
+void logCommit(LogRecord_t &record) {
+    record.ticks = xTaskGetTickCount();
+
+    // Nobody waits for the log, a full queue drops the message
+    if (!deferredRecords.push(record)) droppedMessages++;
+}
+
+void logSetSink(ILogSink *newSink) {
+    logFlush();
+
+    while (writing.test_and_set(std::memory_order_acquire)) {
+        vTaskDelay(1);
+    }
+
+    sink = newSink;
+
+    writing.clear(std::memory_order_release);
+}
+
+void logFlush() {
+    writeLines(true);
+}
+
+uint32_t logGetDroppedMessages() {
+    return (droppedMessages.load(std::memory_order_relaxed));
+}
+
+uint32_t logGetTruncatedMessages() {
+    return (truncatedMessages.load(std::memory_order_relaxed));
+}
+
+bool logPop(LogRecord_t &record) {
+    return (deferredRecords.pop(record));
+}
+
+size_t logFormat(char *buffer, size_t bufferSize, const LogRecord_t &record) {
+    const char *format = record.format;
+    size_t length      = 0;
+    uint8_t argument   = 0;
+
+    if (bufferSize == 0) return (0);
+
+    buffer[0] = '\0';
+
+    length = formatTime(buffer, bufferSize, record.ticks);
+
+    while (*format != '\0') {
+        const char *percent = strchr(format, '%');
+        size_t literal      = percent ? percent - format : strlen(format);
+
+        length = advance(length, snprintf(&buffer[length], bufferSize - length, "%.*s", static_cast<int>(literal), format), bufferSize);
+        format += literal;
+
+        if (percent == NULL) break;
+
+        // Copy "%[flags][width][.precision][length]conversion" on its own
+        char specifier[maxSpecifier];
+        size_t specifierLength = 0;
+
+        do {
+            specifier[specifierLength++] = *format++;
+        } while (*format != '\0' && specifierLength < maxSpecifier - 1 && strchr("-+ #0123456789.hljztL", *format));
+
+        if (*format != '\0' && specifierLength < maxSpecifier - 1) {
+            specifier[specifierLength++] = *format++;
+        }
+
+        specifier[specifierLength] = '\0';
+
+        if (strcmp(specifier, "%%") == 0) {
+            length = advance(length, snprintf(&buffer[length], bufferSize - length, "%%"), bufferSize);
+        } else if (argument < record.numArguments) {
+            length = advance(length, formatArgument(&buffer[length], bufferSize - length, specifier, record.arguments[argument++]), bufferSize);
+        }
+    }
+
+    return (length);
+}
+
+bool logProcess() {
+    LogRecord_t record;
+    LogLine_t line;
+
+    if (!logPop(record)) {
+        // Nothing new, but a batch may have become old enough
+        writeLines(false);
+        return (false);
+    }
+
+    line.length = truncateLine(line, logFormat(line.text, sizeof(line.text), record), record.format);
+    commitLine(line);
+
+    return (true);
 }
 
 } /* namespace xXx */
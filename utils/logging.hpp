@@ -4,22 +4,235 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include <type_traits>
 
+#include <xXx/interfaces/ilogsink.hpp>
 
+#ifndef LOG_DEFERRED_RECORDS
+#define LOG_DEFERRED_RECORDS 32
+#endif
+
+// Every message is formatted into a line of this size on the caller's stack,
+// longer ones end in "..." and are counted, see logGetTruncatedMessages()
+#ifndef LOG_LINE_SIZE
+#define LOG_LINE_SIZE 128
+#endif
+
+// Complete lines waiting to be written, must be a power of two
+#ifndef LOG_LINES
+#define LOG_LINES 8
+#endif
+
+/*
+ * Lines are collected in one of two buffers of this size and go to the sink
+ * in one write once the buffer is full or its oldest line is LOG_BATCH_TICKS
+ * old. Nothing flushes on a timer: the age is only checked whenever a line is
+ * logged and by logProcess(), so a quiet system keeps its last lines until
+ * then or until logFlush(). The default 0 writes every line right away, only
+ * raise it where a task calls logProcess() regularly.
+ */
+#ifndef LOG_BATCH_SIZE
+#define LOG_BATCH_SIZE 256
+#endif
+
+#ifndef LOG_BATCH_TICKS
+#define LOG_BATCH_TICKS 0
+#endif
 
+// ----- Levels ---------------------------------------------------------------
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+#define LOG_LEVEL_TRACE 5
+
+#ifndef LOG_LEVEL
 #if defined(NDEBUG)
-#define HEXDUMP(...)
-#define LOG(...)
+#define LOG_LEVEL LOG_LEVEL_NONE
+#else
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+#endif
+
+// ----- Modules --------------------------------------------------------------
+
+/*
+ * A source file selects its module before it includes anything:
+ *
+ *     #define LOG_MODULE RF24
+ *
+ * LOG_LEVEL_<module> defaults to LOG_LEVEL and is set per module at compile
+ * time, e.g. -DLOG_LEVEL_RF24=LOG_LEVEL_WARNING. A module without such a
+ * definition logs nothing.
+ */
+
+#ifndef LOG_MODULE
+#define LOG_MODULE APP
+#endif
+
+#ifndef LOG_LEVEL_APP
+#define LOG_LEVEL_APP LOG_LEVEL
+#endif
+
+#ifndef LOG_LEVEL_OS
+#define LOG_LEVEL_OS LOG_LEVEL
+#endif
+
+#ifndef LOG_LEVEL_RF24
+#define LOG_LEVEL_RF24 LOG_LEVEL
+#endif
+
+#ifndef LOG_LEVEL_SENSOR
+#define LOG_LEVEL_SENSOR LOG_LEVEL
+#endif
+
+#ifndef LOG_LEVEL_SUPPORT
+#define LOG_LEVEL_SUPPORT LOG_LEVEL
+#endif
+
+#ifndef LOG_LEVEL_TEMPLATES
+#define LOG_LEVEL_TEMPLATES LOG_LEVEL
+#endif
+
+#define __LOG_LEVEL_OF_(module) LOG_LEVEL_##module
+#define __LOG_LEVEL_OF(module) __LOG_LEVEL_OF_(module)
+#define __LOG_STRING_(module) #module
+#define __LOG_STRING(module) __LOG_STRING_(module)
+
+#define LOG_MODULE_LEVEL __LOG_LEVEL_OF(LOG_MODULE)
+#define LOG_TAG __LOG_STRING(LOG_MODULE)
+
+// ----- Macros ---------------------------------------------------------------
+
+/*
+ * Messages above the module level are removed by the preprocessor together
+ * with their arguments. The ones that remain are checked against the
+ * runtime threshold, see logSetThreshold().
+ */
+
+#if defined(LOG_DEFERRED)
+#define __LOG_WRITE(...) xXx::logDeferred(__VA_ARGS__)
 #else
+#define __LOG_WRITE(...) xXx::log(__VA_ARGS__)
+#endif
+
+#define __LOG_AT(level, letter, format, ...)                            \
+    do {                                                                \
+        if ((level) <= xXx::logThreshold) {                             \
+            __LOG_WRITE(letter "/" LOG_TAG ": " format, ##__VA_ARGS__); \
+        }                                                               \
+    } while (0)
+
+#if LOG_MODULE_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(format, ...) __LOG_AT(LOG_LEVEL_ERROR, "E", format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(...)
+#endif
+
+#if LOG_MODULE_LEVEL >= LOG_LEVEL_WARNING
+#define LOG_WARNING(format, ...) __LOG_AT(LOG_LEVEL_WARNING, "W", format, ##__VA_ARGS__)
+#else
+#define LOG_WARNING(...)
+#endif
+
+#if LOG_MODULE_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(format, ...) __LOG_AT(LOG_LEVEL_INFO, "I", format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(...)
+#endif
+
+#if LOG_MODULE_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(format, ...) __LOG_AT(LOG_LEVEL_DEBUG, "D", format, ##__VA_ARGS__)
 #define HEXDUMP(...) xXx::hexdump(__VA_ARGS__)
-#define LOG(...) xXx::log(__VA_ARGS__)
+#define LOG(...) __LOG_WRITE(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...)
+#define HEXDUMP(...)
+#define LOG(...)
+#endif
 
+#if LOG_MODULE_LEVEL >= LOG_LEVEL_TRACE
+#define LOG_TRACE(format, ...) __LOG_AT(LOG_LEVEL_TRACE, "T", format, ##__VA_ARGS__)
+#else
+#define LOG_TRACE(...)
 #endif
 
 namespace xXx {
 
+static const size_t logMaxArguments = 6;
+
+// "0x00000000:" + 16 * " 00" + " " + 16 characters + "\n"
+static const size_t hexdumpBytesPerLine = 16;
+static const size_t hexdumpLineLength   = 11 + 3 * hexdumpBytesPerLine + 1 + hexdumpBytesPerLine + 1;
+
+extern uint8_t logThreshold;
+
+/*
+ * A deferred message: the format string is not copied, so it must live
+ * forever (string literals do). The same goes for "%s" arguments.
+ */
+struct LogRecord_t {
+    const char *format;
+    uint32_t ticks;
+    uint8_t numArguments;
+    uint64_t arguments[logMaxArguments];
+};
+
 void hexdump(const void *bytes, size_t numBytes);
+size_t hexdumpFormat(char *buffer, size_t bufferSize, const void *bytes, size_t numBytes);
 void log(const char *format, ...);
+void logSetThreshold(uint8_t level);
+uint32_t logGetDroppedMessages();
+uint32_t logGetTruncatedMessages();
+void logSetSink(ILogSink *sink);
+void logFlush();
+
+void logCommit(LogRecord_t &record);
+bool logPop(LogRecord_t &record);
+size_t logFormat(char *buffer, size_t bufferSize, const LogRecord_t &record);
+bool logProcess();
+
+template <typename TYPE>
+inline typename std::enable_if<std::is_integral<TYPE>::value || std::is_enum<TYPE>::value, uint64_t>::type
+logArgument(TYPE value) {
+    return (static_cast<uint64_t>(value));
+}
+
+template <typename TYPE>
+inline uint64_t logArgument(TYPE *value) {
+    return (reinterpret_cast<uintptr_t>(value));
+}
+
+inline uint64_t logArgument(double value) {
+    uint64_t argument;
+
+    memcpy(&argument, &value, sizeof(argument));
+
+    return (argument);
+}
+
+/*
+ * Stores the format and the raw arguments and returns, the formatting is
+ * done later by logProcess() or by a decoder on the host. Widths and
+ * precisions given as "*" are not supported.
+ */
+template <typename... ARGUMENTS>
+void logDeferred(const char *format, ARGUMENTS... arguments) {
+    static_assert(sizeof...(ARGUMENTS) <= logMaxArguments, "Too many arguments for a deferred log message");
+
+    // The leading zero keeps the array from being empty
+    const uint64_t values[] = {0, logArgument(arguments)...};
+    LogRecord_t record;
+
+    record.format       = format;
+    record.numArguments = sizeof...(ARGUMENTS);
+    memcpy(record.arguments, &values[1], sizeof...(ARGUMENTS) * sizeof(uint64_t));
+
+    logCommit(record);
+}
 
 } /* namespace xXx */
 
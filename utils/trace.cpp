@@ -0,0 +1,128 @@
+#include <atomic>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "trace.hpp"
+
+static_assert((TRACE_EVENTS & (TRACE_EVENTS - 1)) == 0, "TRACE_EVENTS must be a power of two");
+
+static const size_t lineSize = 160;
+
+static xXx::TraceEvent_t events[TRACE_EVENTS];
+static std::atomic<uint32_t> head(0);
+static std::atomic<bool> recording(true);
+
+static const char *phase(xXx::TraceType type) {
+    switch (type) {
+        case xXx::TraceType::Begin: return ("B");
+        case xXx::TraceType::End: return ("E");
+        case xXx::TraceType::Instant: return ("i");
+        case xXx::TraceType::Counter: return ("C");
+        default: return ("i");
+    }
+}
+
+// Longer names are cut, so the fixed part of an event always fits
+static const int nameSize = 40;
+
+// One event in the Chrome trace event format, see "Trace Event Format"
+static int formatEvent(char *line, const xXx::TraceEvent_t &event, uint32_t origin, bool first) {
+    uint64_t us = TRACE_TIMESTAMP_TO_US(event.timestamp - origin);
+    char suffix[40];
+    int length;
+
+    if (event.type == xXx::TraceType::Instant) {
+        snprintf(suffix, sizeof(suffix), ",\"s\":\"t\"}");
+    } else if (event.type == xXx::TraceType::Counter) {
+        snprintf(suffix, sizeof(suffix), ",\"args\":{\"value\":%" PRId32 "}}", event.value);
+    } else {
+        snprintf(suffix, sizeof(suffix), "}");
+    }
+
+    length = snprintf(line, lineSize, "%s{\"name\":\"%.*s\",\"ph\":\"%s\",\"ts\":%" PRIu64 ",\"pid\":0,\"tid\":%" PRIuPTR "%s",
+                      first ? "" : ",\n", nameSize, event.name, phase(event.type), us,
+                      reinterpret_cast<uintptr_t>(event.task), suffix);
+
+    if (length < 0) return (0);
+
+    return (length < static_cast<int>(lineSize) ? length : lineSize - 1);
+}
+
+namespace xXx {
+
+// Safe from tasks and interrupts, every caller claims its own slot
+void traceRecord(TraceType type, const char *name, int32_t value) {
+    traceRecord(type, name, value, TRACE_IN_ISR() ? NULL : xTaskGetCurrentTaskHandle());
+}
+
+void traceRecord(TraceType type, const char *name, int32_t value, void *task) {
+    if (!recording.load(std::memory_order_relaxed)) return;
+
+    uint32_t index      = head.fetch_add(1, std::memory_order_relaxed);
+    TraceEvent_t &event = events[index & (TRACE_EVENTS - 1)];
+
+    event.timestamp = TRACE_TIMESTAMP();
+    event.name      = name;
+    event.task      = task;
+    event.value     = value;
+    event.type      = type;
+}
+
+void traceStart() {
+    recording.store(true, std::memory_order_relaxed);
+}
+
+void traceStop() {
+    recording.store(false, std::memory_order_relaxed);
+}
+
+void traceClear() {
+    head.store(0, std::memory_order_relaxed);
+}
+
+size_t traceGetEvents() {
+    uint32_t recorded = head.load(std::memory_order_relaxed);
+
+    return (recorded < TRACE_EVENTS ? recorded : TRACE_EVENTS);
+}
+
+/*
+ * Writes the recorded events as Chrome trace JSON, which chrome://tracing and
+ * ui.perfetto.dev open directly. Stop the recording before, otherwise events
+ * may be overwritten while they are read.
+ */
+void traceExport(ILogSink &sink) {
+    static const char header[] = "{\"traceEvents\":[\n";
+    static const char footer[] = "\n]}\n";
+
+    // The sink may still read the previous line, see ILogSink
+    char lines[2][lineSize];
+    uint32_t last  = head.load(std::memory_order_acquire);
+    uint32_t first = last - traceGetEvents();
+    uint32_t origin;
+
+    sink.write(reinterpret_cast<const uint8_t *>(header), sizeof(header) - 1);
+
+    if (first != last) {
+        origin = events[first & (TRACE_EVENTS - 1)].timestamp;
+
+        for (uint32_t i = first; i != last; i++) {
+            char *line = lines[i & 1];
+            int length = formatEvent(line, events[i & (TRACE_EVENTS - 1)], origin, i == first);
+
+            sink.write(reinterpret_cast<const uint8_t *>(line), length);
+        }
+    }
+
+    sink.write(reinterpret_cast<const uint8_t *>(footer), sizeof(footer) - 1);
+}
+
+} /* namespace xXx */
+
+// Runs in the context switch, where the current task is the incoming one
+void traceTaskSwitchedIn(void) {
+    xXx::traceRecord(xXx::TraceType::Instant, "task switch", 0, xTaskGetCurrentTaskHandle());
+}
@@ -0,0 +1,117 @@
+#ifndef TRACE_HPP_
+#define TRACE_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <xXx/interfaces/ilogsink.hpp>
+
+// Recorded events, the oldest ones are overwritten. Must be a power of two.
+#ifndef TRACE_EVENTS
+#define TRACE_EVENTS 256
+#endif
+
+/*
+ * The timestamp of an event and its conversion to microseconds. The default
+ * is the tick count, a cycle counter gives much finer results:
+ *
+ *     -DTRACE_TIMESTAMP()=DWT->CYCCNT
+ *     -DTRACE_TIMESTAMP_TO_US(t)=((t)/(SystemCoreClock/1000000))
+ *
+ * Both are only used by trace.cpp.
+ */
+#ifndef TRACE_TIMESTAMP
+#define TRACE_TIMESTAMP() xTaskGetTickCount()
+#endif
+
+#ifndef TRACE_TIMESTAMP_TO_US
+#define TRACE_TIMESTAMP_TO_US(t) (static_cast<uint64_t>(t) * portTICK_PERIOD_MS * 1000)
+#endif
+
+/*
+ * Whether traceRecord() runs in an interrupt, whose events are exported with
+ * tid 0 instead of the interrupted task. The default needs a port that has
+ * xPortIsInsideInterrupt() (the Cortex-M ones do).
+ */
+#ifndef TRACE_IN_ISR
+#define TRACE_IN_ISR() (xPortIsInsideInterrupt() == pdTRUE)
+#endif
+
+// ----- Macros ---------------------------------------------------------------
+
+/*
+ * Names are stored as pointers and must live forever (string literals do).
+ * Without TRACE_ENABLED the macros are removed together with their
+ * arguments.
+ */
+
+#define __TRACE_CONCAT_(a, b) a##b
+#define __TRACE_CONCAT(a, b) __TRACE_CONCAT_(a, b)
+
+#if defined(TRACE_ENABLED)
+#define TRACE_BEGIN(name) xXx::traceRecord(xXx::TraceType::Begin, name, 0)
+#define TRACE_END(name) xXx::traceRecord(xXx::TraceType::End, name, 0)
+#define TRACE_INSTANT(name) xXx::traceRecord(xXx::TraceType::Instant, name, 0)
+#define TRACE_COUNTER(name, value) xXx::traceRecord(xXx::TraceType::Counter, name, value)
+#define TRACE_SCOPE(name) xXx::TraceScope __TRACE_CONCAT(__traceScope, __LINE__)(name)
+#else
+#define TRACE_BEGIN(name)
+#define TRACE_END(name)
+#define TRACE_INSTANT(name)
+#define TRACE_COUNTER(name, value)
+#define TRACE_SCOPE(name)
+#endif
+
+namespace xXx {
+
+enum class TraceType : uint8_t
+{
+    Begin,
+    End,
+    Instant,
+    Counter
+};
+
+struct TraceEvent_t {
+    uint32_t timestamp;
+    const char *name;
+    void *task; // NULL in interrupts
+    int32_t value;
+    TraceType type;
+};
+
+void traceRecord(TraceType type, const char *name, int32_t value);
+// For hooks that run in an interrupt on behalf of a task
+void traceRecord(TraceType type, const char *name, int32_t value, void *task);
+void traceStart();
+void traceStop();
+void traceClear();
+size_t traceGetEvents();
+void traceExport(ILogSink &sink);
+
+class TraceScope {
+   private:
+    const char *_name;
+
+   public:
+    TraceScope(const char *name)
+        : _name(name) {
+        traceRecord(TraceType::Begin, _name, 0);
+    }
+
+    ~TraceScope() {
+        traceRecord(TraceType::End, _name, 0);
+    }
+};
+
+} /* namespace xXx */
+
+/*
+ * Task switches, map the FreeRTOS hook onto it in FreeRTOSConfig.h:
+ *
+ *     void traceTaskSwitchedIn(void);
+ *     #define traceTASK_SWITCHED_IN() traceTaskSwitchedIn()
+ */
+extern "C" void traceTaskSwitchedIn(void);
+
+#endif /* TRACE_HPP_ */